@@ -1331,6 +1331,9 @@ ARDOUR_UI::update_peak_thread_work ()
 		const char* const bg = c > 2 ? " background=\"red\" foreground=\"white\"" : "";
 		snprintf (buf, sizeof (buf), "<span %s>%d</span>", bg, c);
 		peak_thread_work_label.set_markup (label + buf);
+		if (editor) {
+			editor->prioritize_visible_peakfiles ();
+		}
 	} else {
 		peak_thread_work_label.set_markup (X_(""));
 	}
@@ -1361,7 +1364,15 @@ ARDOUR_UI::format_disk_space_label (float remain_sec)
 	int mins = (sec / 60) % 60;
 	int secs = sec % 60;
 	snprintf (buf, sizeof(buf), _("%02dh:%02dm:%02ds"), hrs, mins, secs);
-	ArdourWidgets::set_tooltip (disk_space_label, string_compose ("%1: %2", _("Available record time"), buf));
+	std::string tip = string_compose ("%1: %2", _("Available record time"), buf);
+
+	if (_session && (_session->actively_recording () || _session->capture_duration () > 0)) {
+		/* how close the current (or last) take came to a disk overrun */
+		snprintf (buf, sizeof (buf), "%.0f%%", 100.f * DiskWriter::capture_margin ());
+		tip += string_compose ("\n%1: %2", _("Smallest free capture buffer space"), buf);
+	}
+
+	ArdourWidgets::set_tooltip (disk_space_label, tip);
 
 	std::string label = string_compose (X_("<span weight=\"ultralight\">%1</span>: "), _("Rec"));
 
@@ -157,10 +157,12 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("use-video-file-fps"), _("video"), _("use"), _("frames"), _("per"), _("second"), _("fps"),  NULL);
 	VAR_META (X_("afl-position"), _("monitoring"), _("monitor"), _("afl"), _("pfl"), _("pre"), _("post"), _("position"),  NULL);
 	VAR_META (X_("auto-analyse-audio"), _("automatic"), _("automated"), _("audio"), _("analysis"), _("transients"),  NULL);
+	VAR_META (X_("capture-write-behind"), _("performance"), _("disk"), _("i/o"), _("io"), _("recording"), _("capture"), _("write"), _("cache"), _("preallocate"),  NULL);
 	VAR_META (X_("click-emphasis-sound"), _("metronome"), _("click"), _("beat"), _("downbeat"), _("emphasis"), _("sample"), _("sound"),  NULL);
 	VAR_META (X_("click-gain"), _("metronome"), _("click"), _("beat"), _("volume"), _("gain"), _("level"),  NULL);
 	VAR_META (X_("click-sound"), _("metronome"), _("click"), _("beat"), _("sound"), _("sample"),  NULL);
 	VAR_META (X_("clip-library-dir"), _("folder"), _("folders"), _("directory"), _("directories"), _("download"), _("clips"), _("library"),  NULL);
+	VAR_META (X_("clip-memory-megabytes"), _("triggering"), _("clips"), _("slots"), _("memory"), _("cache"), _("budget"), _("ram"), _("streaming"),  NULL);
 	VAR_META (X_("cpu-dma-latency"), _("cpu"), _("dma"), _("latency"), _("performance"), _("xrun"),  NULL);
 	VAR_META (X_("create-xrun-marker"), _("xrun"), _("xmarker"),  NULL);
 	VAR_META (X_("default-automation-time-domain"), _("automation"), _("time"), _("domain"), _("default"),  NULL);
@@ -169,10 +171,12 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("denormal-model"), _("denormal"), _("model"), _("handling"), _("cpu"), _("performance"), _("speed"), _("xruns"), _("dsp"), _("load"),  NULL);
 	VAR_META (X_("denormal-protection"), _("denormal"), _("model"), _("handling"), _("cpu"), _("performance"), _("speed"), _("xruns"), _("dsp"), _("load"),  NULL);
 	VAR_META (X_("discover-plugins-on-start"), _("plugins"), _("scan"), _("discover"), _("rescan"), _("reload"), _("startup"),  NULL);
+	VAR_META (X_("graph-work-stealing"), _("performance"), _("cpu"), _("threads"), _("cache"), _("scheduling"), _("parallel"), _("work"), _("stealing"),  NULL);
 	VAR_META (X_("history-depth"), _("history"), _("undo"), _("redo"), _("depth"), _("length"), _("size"),  NULL);
 	VAR_META (X_("layer-model"), _("editing"), _("layering"), _("model"), _("style"), _("type"),  NULL);
 	VAR_META (X_("link-send-and-route-panner"), _("mixing"), _("panning"), _("send"), _("panner"), _("link"), _("connect"), _("tie"),  NULL);
 	VAR_META (X_("listen-position"), _("afl"), _("pfl"), _("listen"), _("monitoring"), _("position"),  NULL);
+	VAR_META (X_("locate-prefetch-megabytes"), _("performance"), _("disk"), _("i/o"), _("io"), _("cache"), _("memory"), _("locate"), _("marker"), _("loop"), _("prefetch"),  NULL);
 	VAR_META (X_("loop-fade-choice"), _("looping"), _("fades"), _("fadein"), _("fadeout"), _("choice"), _("type"), _("style"), _("model"),  NULL);
 	VAR_META (X_("loop-is-mode"), _("looping"), _("mode"), _("behavior"),  NULL);
 	VAR_META (X_("ltc-output-port"), _("timecode"), _("output"), _("port"), _("routing"),  NULL);
@@ -227,6 +231,7 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("ripple-mode"), _("ripple"), _("all"), _("interview"), _("selected"),  NULL);
 	VAR_META (X_("run-all-transport-masters-always"), _("synchronization"), _("always"), _("run"), _("masters"), _("transport"),  NULL);
 	VAR_META (X_("sample-lib-path"), _("files"), _("folders"), _("samples"), _("library"), _("path"),  NULL);
+	VAR_META (X_("save-automation-sidecar"), _("performance"), _("automation"), _("save"), _("load"), _("binary"), _("file"), _("session"),  NULL);
 	VAR_META (X_("save-history"), _("history"), _("save"), _("disk"), _("serialize"), _("store"),  NULL);
 	VAR_META (X_("save-history-depth"), _("history"), _("depth"), _("size"), _("length"),  NULL);
 	VAR_META (X_("send-ltc"), _("synchronization"), _("send"), _("transmit"), _("deliver"), _("linear"), _("timecode"), _("ltc"),  NULL);
@@ -252,6 +257,7 @@ UIConfiguration::build_metadata ()
 	VAR_META (X_("use-macvst"), _("plugins"), _("vst2"), _("enable"), _("disable"),  NULL);
 	VAR_META (X_("use-monitor-bus"), _("monitoring"), _("bus"), _("optional"),  NULL);
 	VAR_META (X_("use-osc"), _("osc"), _("open"), _("sound"), _("control"),  NULL);
+	VAR_META (X_("use-peak-pyramid"), _("performance"), _("waveform"), _("peaks"), _("zoom"), _("disk"), _("cache"),  NULL);
 	VAR_META (X_("use-plugin-own-gui"), _("plugins"), _("GUI"), _("editor"), _("prefer"), _("use"), _("own"),  NULL);
 	VAR_META (X_("use-vst3"), _("plugins"), _("vst3"),  NULL);
 	VAR_META (X_("verbose-plugin-scan"), _("plugins"), _("scanning"), _("verbose"),  NULL);
@@ -84,6 +84,7 @@
 #include "ardour/route.h"
 #include "ardour/route_group.h"
 #include "ardour/session_playlists.h"
+#include "ardour/source_factory.h"
 #include "ardour/tempo.h"
 #include "ardour/utils.h"
 #include "ardour/vca_manager.h"
@@ -4039,6 +4040,45 @@ Editor::visual_changer (const VisualChange& vc)
 
 	_region_peak_cursor->hide ();
 	_summary->set_overlays_dirty ();
+
+	prioritize_visible_peakfiles ();
+}
+
+static void
+add_audio_sources_if_covered (RegionView* rv, Temporal::TimeRange const* range, std::vector<std::shared_ptr<AudioSource>>* sources)
+{
+	std::shared_ptr<AudioRegion> ar (std::dynamic_pointer_cast<AudioRegion> (rv->region ()));
+	if (!ar || ar->coverage (range->start (), range->end ()) == Temporal::OverlapNone) {
+		return;
+	}
+	for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+		sources->push_back (ar->audio_source (n));
+	}
+}
+
+void
+Editor::prioritize_visible_peakfiles ()
+{
+	if (!_session || SourceFactory::peak_work_queue_length () == 0) {
+		return;
+	}
+
+	Temporal::TimeRange const range (timepos_t (_leftmost_sample), timepos_t (_leftmost_sample + current_page_samples ()));
+	std::vector<std::shared_ptr<AudioSource>> sources;
+
+	TrackViewList tvl;
+	get_onscreen_tracks (tvl);
+
+	for (auto const& tv : tvl) {
+		if (tv->hidden () || !tv->view ()) {
+			continue;
+		}
+		tv->view ()->foreach_regionview (sigc::bind (sigc::ptr_fun (add_audio_sources_if_covered), &range, &sources));
+	}
+
+	if (!sources.empty ()) {
+		SourceFactory::prioritize_peakfiles (sources);
+	}
 }
 
 void
@@ -293,6 +293,7 @@ public:
 	void clear_grouped_playlists (RouteUI* v);
 
 	void get_onscreen_tracks (TrackViewList&);
+	void prioritize_visible_peakfiles ();
 
 	Width editor_mixer_strip_width;
 	void maybe_add_mixer_strip_width (XMLNode&) const;
@@ -984,6 +984,7 @@ Editor::tie_vertical_scrolling ()
 	}
 	_group_tabs->set_offset (vertical_adjustment.get_value ());
 	controls_layout.queue_draw ();
+	prioritize_visible_peakfiles ();
 }
 
 void
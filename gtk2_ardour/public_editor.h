@@ -154,6 +154,9 @@ public:
 	 */
 	virtual void consider_auditioning (std::shared_ptr<ARDOUR::Region> r) = 0;
 
+	/** move sources of regions that are on screen to the front of the peak building queue */
+	virtual void prioritize_visible_peakfiles () = 0;
+
 	/* import dialogs -> ardour-ui ?! */
 	virtual void external_audio_dialog () = 0;
 	virtual void session_import_dialog () = 0;
@@ -4827,6 +4827,15 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		bo = new BoolOption (
+				"graph-work-stealing",
+				_("Keep processing on the thread that produced a route's input"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_work_stealing),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_work_stealing)
+				);
+		add_option (_("Performance"), bo);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(), _("When enabled, each DSP thread queues downstream routes locally and idle threads steal work from busy ones. This improves cache locality and reduces contention with many processors and routes."));
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -4973,6 +4982,41 @@ These settings will only take effect after %1 is restarted.\n\
 #endif
 	}
 
+	ComboOption<uint32_t>* lpf = new ComboOption<uint32_t> (
+			"locate-prefetch-megabytes",
+			_("Memory for locate prefetch"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_locate_prefetch_megabytes),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_locate_prefetch_megabytes)
+			);
+	lpf->add (0, _("Disabled"));
+	lpf->add (64, _("64 MB"));
+	lpf->add (128, _("128 MB"));
+	lpf->add (256, _("256 MB"));
+	lpf->add (512, _("512 MB"));
+	lpf->add (1024, _("1 GB"));
+	Gtkmm2ext::UI::instance()->set_tip (lpf->tip_widget(), _("While the disk is otherwise idle, read audio at the loop start, punch-in, markers and recently used locate positions into memory, so that locating to these positions does not have to wait for the disk."));
+	add_option (_("Performance"), lpf);
+
+#ifdef __linux__
+	bo = new BoolOption (
+			"capture-write-behind",
+			_("Preallocate capture files and limit write caching"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_capture_write_behind),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_capture_write_behind)
+			);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(), _("When recording, reserve disk space for new files in large chunks, and write recorded data back to disk continuously rather than keeping it in the system's file cache. This reduces stalls when recording many tracks at once."));
+	add_option (_("Performance"), bo);
+#endif
+
+	bo = new BoolOption (
+			"save-automation-sidecar",
+			_("Store dense automation in binary files"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_save_automation_sidecar),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_save_automation_sidecar)
+			);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(), _("When saving a session, store automation with many points in binary files in the session's automation folder instead of the session file. This makes saving and loading sessions with dense automation faster. Sessions saved this way cannot be opened by older versions of Ardour. Templates and archives always store automation in the session file."));
+	add_option (_("Performance"), bo);
+
 	/* Image cache size */
 	add_option (_("Performance"), new OptionEditorHeading (_("Memory Usage")));
 
@@ -4988,6 +5032,15 @@ These settings will only take effect after %1 is restarted.\n\
 		 _("Increasing the cache size uses more memory to store waveform images, which can improve graphical performance."));
 	add_option (_("Performance"), sics);
 
+	bo = new BoolOption (
+			"use-peak-pyramid",
+			_("Keep multi-resolution waveform peak files"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_use_peak_pyramid),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_use_peak_pyramid)
+			);
+	add_option (_("Performance"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(), _("When enabled, reduced copies of the waveform peak data are stored next to each peak file. This speeds up drawing waveforms of long regions when zoomed out, at the cost of slightly more disk space."));
+
 	add_option (_("Performance"), new OptionEditorHeading (_("Automation")));
 
 	add_option (_("Performance"),
@@ -5041,6 +5094,21 @@ These settings will only take effect after %1 is restarted.\n\
 	                                   "or a regular MIDI device capable of sending sequential note numbers (like a typical keyboard)"));
 	add_option (_("Triggering"), dtip);
 
+	ComboOption<uint32_t>* cmm = new ComboOption<uint32_t> (
+			"clip-memory-megabytes",
+			_("Memory for clip audio data"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_clip_memory_megabytes),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_clip_memory_megabytes)
+			);
+	cmm->add (512, _("512 MB"));
+	cmm->add (1024, _("1 GB"));
+	cmm->add (2048, _("2 GB"));
+	cmm->add (4096, _("4 GB"));
+	cmm->add (8192, _("8 GB"));
+	cmm->add (16384, _("16 GB"));
+	set_tooltip (cmm->tip_widget(), _("Audio clips are kept in memory, and clips using the same audio share the data. Clips that do not fit into this budget are streamed from disk while they play.\n\nThis only affects clips that are loaded after the setting has been changed."));
+	add_option (_("Triggering"), cmm);
+
 	add_option (_("Triggering"), new OptionEditorHeading (_("Clip Library")));
 
 	add_option (_("Triggering"), new DirectoryOption (
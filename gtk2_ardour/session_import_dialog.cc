@@ -20,6 +20,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <glibmm/miscutils.h>
+
 #include <ytkmm/messagedialog.h>
 #include <ytkmm/stock.h>
 
@@ -28,6 +30,8 @@
 #include "ardour/audio_region_importer.h"
 #include "ardour/audio_playlist_importer.h"
 #include "ardour/audio_track_importer.h"
+#include "ardour/automation_sidecar.h"
+#include "ardour/directory_names.h"
 #include "ardour/filename_extensions.h"
 #include "ardour/location_importer.h"
 #include "ardour/tempo_map_importer.h"
@@ -120,6 +124,11 @@ SessionImportDialog::load_session (const string& filename)
 			error << string_compose (_("Cannot load XML for session from %1"), filename) << endmsg;
 			return;
 		}
+
+		/* automation events may be stored next to the other session's state file */
+		if (tree.root ()) {
+			AutomationSidecar::inline_events (*tree.root (), Glib::build_filename (Glib::path_get_dirname (filename), automation_dir_name));
+		}
 		std::shared_ptr<AudioRegionImportHandler> region_handler (new AudioRegionImportHandler (tree, *_session));
 		std::shared_ptr<AudioPlaylistImportHandler> pl_handler (new AudioPlaylistImportHandler (tree, *_session, *region_handler));
 
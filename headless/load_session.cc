@@ -18,6 +18,7 @@
  */
 
 #include <cstdlib>
+#include <fstream>
 #include <getopt.h>
 #include <iostream>
 
@@ -58,6 +59,10 @@ static string backend_name = "JACK/Pipewire";
 static string backend_name = "JACK";
 #endif
 
+static uint32_t  benchmark_cycles = 0;
+static string    benchmark_output;
+static pframes_t buffer_size = 0;
+
 /** @param dir Session directory.
  *  @param state Session state file, without .ardour suffix.
  */
@@ -77,6 +82,16 @@ load_session (string dir, string state)
 		exit (EXIT_FAILURE);
 	}
 
+	if (benchmark_cycles > 0 && engine->current_backend ()->set_driver ("Benchmark")) {
+		std::cerr << "Cannot set Audio/MIDI engine backend to process as fast as possible\n";
+		exit (EXIT_FAILURE);
+	}
+
+	if (buffer_size > 0 && engine->set_buffer_size (buffer_size)) {
+		std::cerr << "Cannot set Audio/MIDI engine buffer size\n";
+		exit (EXIT_FAILURE);
+	}
+
 	if (engine->start () != 0) {
 		std::cerr << "Cannot start Audio/MIDI engine\n";
 		exit (EXIT_FAILURE);
@@ -87,6 +102,58 @@ load_session (string dir, string state)
 	return session;
 }
 
+/** process benchmark_cycles as fast as possible, and write statistics as JSON */
+static int
+run_benchmark (Session* s)
+{
+	AudioEngine* engine = AudioEngine::instance ();
+
+	/* only measure cycles with the transport rolling */
+	for (int timeout = 1000; !s->transport_rolling (); --timeout) {
+		if (timeout == 0 || !engine->running ()) {
+			cerr << "The transport did not start\n";
+			return EXIT_FAILURE;
+		}
+		Glib::usleep (10000);
+	}
+
+	if (engine->start_benchmark (benchmark_cycles)) {
+		cerr << "Cannot start benchmark\n";
+		return EXIT_FAILURE;
+	}
+
+	while (!engine->benchmark_done ()) {
+		if (!engine->running ()) {
+			cerr << "The audio backend stopped during the benchmark\n";
+			return EXIT_FAILURE;
+		}
+		if (!s->transport_rolling ()) {
+			cerr << "The transport stopped during the benchmark\n";
+			return EXIT_FAILURE;
+		}
+		Glib::usleep (10000);
+	}
+
+	if (engine->benchmark_underruns () > 0) {
+		cerr << "Warning: disk i/o did not keep up (" << engine->benchmark_underruns () << " underruns), results are not representative\n";
+	}
+
+	if (benchmark_output.empty ()) {
+		cout << engine->benchmark_report ();
+		return EXIT_SUCCESS;
+	}
+
+	std::ofstream f (benchmark_output.c_str ());
+	f << engine->benchmark_report ();
+	f.close ();
+
+	if (!f) {
+		cerr << "Cannot write benchmark results to '" << benchmark_output << "'\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
 static void
 access_action (const std::string& action_group, const std::string& action_item)
 {
@@ -140,11 +207,15 @@ print_help ()
 	     << "  SNAPSHOT_NAME               Name of session/snapshot to load (without .ardour at end\n"
 	     << "  -v, --version               Show version information\n"
 	     << "  -h, --help                  Print this message\n"
+	     << "  -b, --benchmark <cycles>    Process <cycles> as fast as possible using the Dummy backend,\n"
+	     << "                              print statistics as JSON and exit\n"
 	     << "  -c, --name <name>           Use a specific backend client name, default is ardour\n"
 	     << "  -d, --disable-plugins       Disable all plugins in an existing session\n"
 	     << "  -D, --debug <options>       Set debug flags. Use \"-D list\" to see available options\n"
+	     << "  -o, --output <file>         Write benchmark statistics to <file> instead of stdout\n"
 	     << "  -O, --no-hw-optimizations   Disable h/w specific optimizations\n"
 	     << "  -P, --no-connect-ports      Do not connect any ports at startup\n"
+	     << "  -s, --buffer-size <samples> Set the engine's buffer size\n"
 #ifdef WINDOWS_VST_SUPPORT
 	     << "  -V, --novst                 Do not use VST support\n"
 #endif
@@ -154,18 +225,21 @@ print_help ()
 int
 main (int argc, char* argv[])
 {
-	const char* optstring = "vhBdD:c:OU:P";
+	const char* optstring = "vhb:BdD:c:o:OU:Ps:";
 
 	/* clang-format off */
 	const struct option longopts[] = {
 		{ "version",             no_argument,       0, 'v' },
 		{ "help",                no_argument,       0, 'h' },
+		{ "benchmark",           required_argument, 0, 'b' },
 		{ "bypass-plugins",      no_argument,       0, 'B' },
 		{ "disable-plugins",     no_argument,       0, 'd' },
 		{ "debug",               required_argument, 0, 'D' },
 		{ "name",                required_argument, 0, 'c' },
 		{ "no-hw-optimizations", no_argument,       0, 'O' },
 		{ "no-connect-ports",    no_argument,       0, 'P' },
+		{ "output",              required_argument, 0, 'o' },
+		{ "buffer-size",         required_argument, 0, 's' },
 		{ 0, 0, 0, 0 }
 	};
 	/* clang-format on */
@@ -194,6 +268,15 @@ main (int argc, char* argv[])
 				backend_client_name = optarg;
 				break;
 
+			case 'b':
+				if (atoi (optarg) < 1) {
+					cerr << "Invalid number of benchmark cycles\n";
+					exit (EXIT_FAILURE);
+				}
+				benchmark_cycles = atoi (optarg);
+				backend_name = "None (Dummy)";
+				break;
+
 			case 'B':
 				ARDOUR::Session::set_bypass_all_loaded_plugins (true);
 				break;
@@ -212,10 +295,18 @@ main (int argc, char* argv[])
 				try_hw_optimization = false;
 				break;
 
+			case 'o':
+				benchmark_output = optarg;
+				break;
+
 			case 'P':
 				ARDOUR::Port::set_connecting_blocked (true);
 				break;
 
+			case 's':
+				buffer_size = atoi (optarg);
+				break;
+
 			default:
 				print_help ();
 				exit (EXIT_FAILURE);
@@ -272,14 +363,20 @@ main (int argc, char* argv[])
 
 	s->request_roll ();
 
-	char msg;
-	do {
-	} while (0 == xthread.receive (msg, true));
+	int rv = EXIT_SUCCESS;
+
+	if (benchmark_cycles > 0) {
+		rv = run_benchmark (s);
+	} else {
+		char msg;
+		do {
+		} while (0 == xthread.receive (msg, true));
+	}
 
 	AudioEngine::instance ()->remove_session ();
 	delete s;
 	AudioEngine::instance ()->stop ();
 
 	ARDOUR::cleanup ();
-	return 0;
+	return rv;
 }
@@ -107,13 +107,18 @@ Amp::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t /*end_sample*/,
 		const gain_t a = 156.825f / (gain_t)_session.nominal_sample_rate(); // 25 Hz LPF; see Amp::apply_gain for details
 		gain_t lpf = _current_gain;
 
+		/* the automation buffer is not used after this point, replace
+		 * it in-place with the smoothed gain-curve, which can then be
+		 * applied to all channels using a vectorized multiply.
+		 */
+		for (pframes_t nx = 0; nx < nframes; ++nx) {
+			gain_t const g = lpf;
+			lpf += a * (gab[nx] - lpf);
+			gab[nx] = g;
+		}
+
 		for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-			Sample* const sp = i->data();
-			lpf = _current_gain;
-			for (pframes_t nx = 0; nx < nframes; ++nx) {
-				sp[nx] *= lpf;
-				lpf += a * (gab[nx] - lpf);
-			}
+			apply_gain_vector_to_buffer (i->data(), gab, nframes);
 		}
 
 		if (fabsf (lpf) < GAIN_COEFF_SMALL) {
@@ -181,17 +186,28 @@ Amp::apply_gain (BufferSet& bufs, samplecnt_t sample_rate, samplecnt_t nframes,
 	 */
 	const gain_t a = 156.825f / (gain_t)sample_rate; // 25 Hz LPF
 
-	for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
-		Sample* const buffer = i->data();
-		double lpf = initial;
+	/* The gain-curve is identical for all channels. Compute it once
+	 * per chunk, and apply it to each channel using a vector multiply.
+	 */
+	gain_t    curve[128];
+	double    lpf  = initial;
+	pframes_t done = 0;
+
+	while (done < nframes) {
+		pframes_t const n = std::min<samplecnt_t> (nframes - done, 128);
 
-		for (pframes_t nx = 0; nx < nframes; ++nx) {
-			buffer[nx] *= lpf;
+		for (pframes_t nx = 0; nx < n; ++nx) {
+			curve[nx] = lpf;
 			lpf += a * (target - lpf);
 		}
-		if (i == bufs.audio_begin()) {
-			rv = lpf;
+		for (BufferSet::audio_iterator i = bufs.audio_begin(); i != bufs.audio_end(); ++i) {
+			apply_gain_vector_to_buffer (i->data() + done, curve, n);
 		}
+		done += n;
+	}
+
+	if (bufs.count().n_audio() > 0) {
+		rv = lpf;
 	}
 
 	if (fabsf (rv - target) < GAIN_COEFF_DELTA) {
@@ -61,10 +61,16 @@ protected:
 	/* special access for PortManager only (hah, C++) */
 	Sample* engine_get_whole_audio_buffer ();
 
+	/* use data resampled by the PortManager for the current cycle,
+	 * instead of resampling the port's input */
+	void set_shared_input (Sample const* d) { _shared_input = d; }
+
 private:
 	AudioBuffer*            _buffer;
 	ArdourZita::VMResampler _src;
 	Sample*                 _data;
+	Sample const*           _shared_input;
+	bool                    _src_idle;
 	bool                    _buf_valid;
 };
 
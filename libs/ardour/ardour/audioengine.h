@@ -46,6 +46,7 @@
 #include "ardour/types.h"
 #include "ardour/chan_count.h"
 #include "ardour/port_manager.h"
+#include "ardour/process_benchmark.h"
 
 class MTDM;
 
@@ -256,6 +257,15 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 
 	PBD::TimingStats dsp_stats[NTT];
 
+	/** record the duration of the next \p n_cycles process cycles.
+	 * @return 0 on success, -1 if the engine is not running
+	 */
+	int         start_benchmark (uint32_t n_cycles);
+	bool        benchmark_done () const { return _benchmark.done (); }
+	std::string benchmark_report () const { return _benchmark.report (); }
+	/** @return the number of disk reader underruns since the benchmark was started */
+	uint32_t    benchmark_underruns () const { return _benchmark.underruns (); }
+
   private:
 	AudioEngine ();
 
@@ -293,6 +303,8 @@ class LIBARDOUR_API AudioEngine : public PortManager, public SessionHandlePtr
 	bool                      _in_destructor;
 
 	std::string               _last_backend_error_string;
+	ProcessBenchmark          _benchmark;
+	PBD::ScopedConnection     _benchmark_connection;
 
 	PBD::Thread*              _hw_reset_event_thread;
 	std::atomic<int>         _hw_reset_request_count;
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <time.h>
@@ -36,6 +37,8 @@
 
 namespace ARDOUR {
 
+class PeakPyramid;
+
 class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioReadable
 {
   public:
@@ -86,6 +89,11 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 		return _build_peakfiles;
 	}
 
+	/** interrupt build_peaks_from_scratch() after the current chunk, see SourceFactory::cancel_peak_building() */
+	void set_peak_building_cancelled (bool yn) {
+		_peak_building_cancelled.store (yn);
+	}
+
 	virtual int setup_peakfile () { return 0; }
 	int close_peakfile ();
 
@@ -99,6 +107,9 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	static bool _build_missing_peakfiles;
 	static bool _build_peakfiles;
 
+	/** path of the (optional) multi-resolution peak file, next to the peakfile */
+	std::string peak_pyramid_path () const;
+
 	/* these collections of working buffers for supporting
 	   playlist's reading from potentially nested/recursive
 	   sources assume SINGLE THREADED reads by the butler
@@ -133,6 +144,7 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 
   private:
 	bool _peaks_built;
+	std::atomic<bool> _peak_building_cancelled;
 	/** This mutex is used to protect both the _peaks_built
 	 *  variable and also the emission (and handling) of the
 	 *  PeaksReady signal.  Holding the lock when emitting
@@ -153,6 +165,10 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable std::unique_ptr<PeakData[]> peak_cache;
+
+	std::unique_ptr<PeakPyramid> _peak_pyramid; // only while writing peaks
+
+	void drop_peak_pyramid ();
 };
 
 }
@@ -126,6 +126,7 @@ public:
 
 private:
 	void create_curve_if_necessary ();
+	int deserialize_sidecar (const XMLNode&, std::string const&);
 	int deserialize_events (const XMLNode&);
 
 	XMLNode& state (bool save_auto_state, bool need_lock) const;
@@ -141,6 +142,17 @@ private:
 	bool operator== (const AutomationList&) const { /* not called */ abort(); return false; }
 	XMLNode* _before; //used for undo of touch start/stop pairs.
 
+	/* serialized events, re-used as long as the list is unchanged:
+	 * either as text, or the sidecar file they were written to.
+	 */
+	mutable Glib::Threads::Mutex _events_xml_lock;
+	mutable std::string          _events_xml;
+	mutable std::string          _events_sidecar;
+	mutable std::string          _events_sidecar_dir;
+	mutable uint64_t             _events_sidecar_checksum;
+	mutable uint64_t             _events_xml_revision;
+	mutable bool                 _events_xml_valid;
+
 };
 
 } // namespace
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pbd/id.h"
+
+class XMLNode;
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Binary storage of automation events, next to the session file.
+ *
+ * Dense automation is expensive to save and load as text. When enabled,
+ * the events of large automation lists are stored in files in the
+ * session's automation directory instead, and the session file only
+ * references them by name and checksum.
+ *
+ * A file starts with a versioned header, followed by the event times
+ * (raw timepos_t values, in the list's time domain) and the event values,
+ * each as a contiguous array of 64 bit numbers in native byte-order,
+ * so that it can be mapped into memory directly.
+ *
+ * Files are named after the list's ID and the checksum of their content,
+ * and are never modified: an unchanged list is not written again, and
+ * older files remain valid for snapshots and backups that refer to them.
+ */
+class LIBARDOUR_API AutomationSidecar
+{
+public:
+	static const uint32_t version    = 1;
+	static const size_t   min_events = 256;
+
+	/** While an instance exists, automation lists that are serialized by
+	 * the calling thread store their events in \p dir (if \p yn is true).
+	 * This is used when saving the session's state, but not for
+	 * undo/redo or templates, which must be self-contained.
+	 */
+	class LIBARDOUR_API Saving
+	{
+	public:
+		Saving (bool yn, std::string const& dir);
+		~Saving ();
+
+	private:
+		std::string const* _old;
+	};
+
+	/** set the directory to load referenced events from */
+	static void set_directory (std::string const& dir);
+
+	/** @return the directory to load referenced events from */
+	static std::string const& directory () { return _directory; }
+
+	/** @return the directory to save to, if events are to be saved to a sidecar in the calling thread */
+	static std::string const* saving () { return _saving; }
+
+	/** write events, unless an identical file already exists.
+	 * @param name set to the file-name to reference
+	 * @param checksum set to the checksum of the data
+	 * @return 0 on success
+	 */
+	static int write (std::string const& dir, PBD::ID const& id, bool beat_time,
+	                  std::vector<int64_t> const& when, std::vector<double> const& value,
+	                  std::string& name, uint64_t& checksum);
+
+	/** read events that were written to \p dir with the given \p name and \p checksum.
+	 * @return 0 on success
+	 */
+	static int read (std::string const& dir, std::string const& name, uint64_t checksum, bool& beat_time,
+	                 std::vector<int64_t>& when, std::vector<double>& value);
+
+	/** Replace all references to events in \p node and its children
+	 * with the events, read from \p dir. This is used for state that
+	 * is imported from another session, whose automation directory
+	 * is not the current session's.
+	 */
+	static void inline_events (XMLNode& node, std::string const& dir);
+
+private:
+	struct Header {
+		char     magic[8];
+		uint32_t version;
+		uint32_t beat_time;
+		uint64_t n_events;
+		uint64_t checksum;
+	};
+
+	static uint64_t compute_checksum (bool beat_time, int64_t const* when, double const* value, size_t n);
+
+	static std::string                     _directory;
+	static thread_local std::string const* _saving;
+};
+
+} // namespace ARDOUR
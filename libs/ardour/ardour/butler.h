@@ -25,6 +25,7 @@
 #include <atomic>
 
 #include <pthread.h>
+#include <vector>
 
 #include <glibmm/threads.h>
 
@@ -63,6 +64,9 @@ public:
 
 	void map_parameters ();
 
+	/** remember a locate target, for prefetching data at recently used positions */
+	void note_locate (samplepos_t);
+
 	bool delegate (sigc::slot<void> const& work) {
 		bool rv = _delegated_work.push_back (work);
 		summon ();
@@ -101,6 +105,7 @@ private:
 	void process_delegated_work ();
 	void config_changed (std::string);
 	bool flush_tracks_to_disk_normal (std::shared_ptr<RouteList const>, uint32_t& errors);
+	bool prefetch_locate_targets (std::shared_ptr<RouteList const>);
 	void queue_request (Request::Type r);
 
 	pthread_t thread;
@@ -114,6 +119,11 @@ private:
 	samplecnt_t _audio_playback_buffer_size;
 	uint32_t    _midi_buffer_size;
 
+	Glib::Threads::Mutex     _recent_locates_lock;
+	std::vector<samplepos_t> _recent_locates; /* most recent first */
+	std::vector<samplepos_t> _prefetch_targets;
+	bool                     _locate_prefetch_active;
+
 	PBD::RingBuffer<PBD::CrossThreadPool*> pool_trash;
 	CrossThreadChannel                    _xthread;
 	PBD::MPMCQueue<sigc::slot<void> >     _delegated_work;
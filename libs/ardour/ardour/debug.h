@@ -96,6 +96,7 @@ namespace PBD {
 		LIBARDOUR_API extern DebugBits RegionFx;
 		LIBARDOUR_API extern DebugBits Selection;
 		LIBARDOUR_API extern DebugBits SessionEvents;
+		LIBARDOUR_API extern DebugBits SessionLoad;
 		LIBARDOUR_API extern DebugBits Slave;
 		LIBARDOUR_API extern DebugBits Solo;
 		LIBARDOUR_API extern DebugBits Soundcloud;
@@ -21,8 +21,11 @@
 #define _ardour_disk_reader_h_
 
 #include <atomic>
-
+#include <memory>
 #include <optional>
+#include <vector>
+
+#include <glibmm/threads.h>
 
 #include "evoral/Curve.h"
 
@@ -81,6 +84,15 @@ public:
 	 */
 	LIBARDOUR_API int do_refill ();
 
+	/** Called by the Butler when there is no other disk work, to read data
+	 * at likely locate targets into memory, so that a later seek() to one of
+	 * them does not need to wait for the disk. At most one target is read per
+	 * call. An empty list drops all data.
+	 *
+	 * @return 1 if data was read, 0 if there is nothing left to do
+	 */
+	LIBARDOUR_API int prefetch_locate_targets (std::vector<samplepos_t> const&);
+
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
@@ -162,7 +174,7 @@ protected:
 	public:
 		DeclickAmp (samplecnt_t sample_rate);
 
-		void apply_gain (AudioBuffer& buf, samplecnt_t n_samples, const float target, sampleoffset_t buffer_offset = 0);
+		void compute_gain_curve (gain_t* curve, samplecnt_t n_samples, const float target);
 
 		float gain () const
 		{
@@ -212,6 +224,7 @@ private:
 	MidiNoteTracker      _tracker;
 	std::optional<bool> _last_read_reversed;
 	std::optional<bool> _last_read_loop;
+	RegionVector        _refill_regions; /* scratch buffer, used by refill_audio() */
 
 	static samplecnt_t _chunk_samples;
 
@@ -251,6 +264,23 @@ private:
 	samplepos_t last_refill_loop_start;
 	void setup_preloop_buffer ();
 
+	/* locate prefetch, data of all channels starting at a
+	 * locate target (minus the rbuf reservation) */
+	struct LocateCacheEntry {
+		samplepos_t start;
+		samplecnt_t length;
+		std::vector<std::unique_ptr<Sample[]> > data;
+	};
+
+	std::vector<LocateCacheEntry> _locate_cache;
+	Glib::Threads::Mutex          _locate_cache_lock;
+	std::atomic<bool>             _locate_cache_dirty;
+
+	static std::atomic<int64_t>   _locate_cache_bytes; /* all disk-readers */
+
+	bool read_locate_cache (samplepos_t start, samplecnt_t min_length, ChannelList const&);
+	void drop_locate_cache ();
+
 	bool _midi_catchup;
 	bool _need_midi_catchup;
 };
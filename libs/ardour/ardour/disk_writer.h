@@ -106,6 +106,14 @@ public:
 
 	static PBD::Signal<void()> Overrun;
 
+	/** @return the smallest fraction of a capture buffer that was still
+	 * free after adding incoming data, since the last call to
+	 * reset_capture_margin(). Values close to zero indicate that an
+	 * Overrun was imminent.
+	 */
+	static float capture_margin () { return _capture_margin.load (); }
+	static void  reset_capture_margin () { _capture_margin.store (1.f); }
+
 	void set_note_mode (NoteMode m);
 
 	/** Emitted when some MIDI data has been received for recording.
@@ -146,6 +154,7 @@ protected:
 
 private:
 	static samplecnt_t _chunk_samples;
+	static std::atomic<float> _capture_margin;
 
 	int add_channel_to (std::shared_ptr<ChannelList>, uint32_t how_many);
 
@@ -24,14 +24,20 @@
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 
+#include <glibmm/threads.h>
+
+#include "pbd/microseconds.h"
 #include "pbd/mpmc_queue.h"
+#include "pbd/ringbuffer.h"
 #include "pbd/semutils.h"
+#include "pbd/ws_deque.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -61,11 +67,42 @@ struct GraphChain {
 	void dump () const;
 	bool plot (std::string const&) const;
 
+	/** Number of dispatch priority levels.
+	 * Nodes are assigned a level according to the length of the longest
+	 * (cost weighted) path from the node to the end of the graph.
+	 */
+	static const int n_priority_levels = 4;
+
 	node_list_t _nodes_rt;
-	/** Nodes that are not fed by any other nodes */
+	/** Nodes that are not fed by any other nodes, sorted by priority */
 	node_list_t _init_trigger_list;
 	/** The number of nodes that do not feed any other node */
 	int _n_terminal_nodes;
+	/** Estimated cost of the longest path through the graph */
+	double _critical_path_cost;
+
+	/** Re-assign priorities using current cost estimates, which include
+	 * measured plugin DSP load. Not realtime safe.
+	 */
+	void refresh_priorities ();
+
+private:
+	void compute_priorities ();
+	bool compute_path_costs (std::map<GraphNode const*, double>&);
+	int  priority_level (double path_cost) const;
+
+	/* serializes priority updates of all chains, which modify the nodes' _graph_priority */
+	static Glib::Threads::Mutex _priority_lock;
+};
+
+/** Timing of a single node (Route or IOPlug) in a process cycle */
+struct LIBARDOUR_API GraphNodeTiming {
+	GraphNode const*    node;   ///< only used as key, may be stale
+	uint32_t            thread; ///< process-thread slot, 0: main thread
+	uint64_t            cycle;  ///< graph cycle count
+	PBD::microseconds_t queued; ///< time when the node became ready to run
+	PBD::microseconds_t start;
+	PBD::microseconds_t end;
 };
 
 class LIBARDOUR_API Graph : public SessionHandleRef
@@ -83,7 +120,7 @@ public:
 	uint32_t n_threads () const;
 
 	/* called by GraphNode */
-	void trigger (ProcessNode* n);
+	void trigger (ProcessNode* n, int priority = 0);
 	void reached_terminal_node ();
 
 	/* called by virtual GraphNode::process() */
@@ -93,6 +130,16 @@ public:
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
 
+	/* per node timing, not realtime safe */
+	void start_node_timing ();
+	void stop_node_timing ();
+	size_t drain_node_timing ();
+	bool write_node_timing (std::string const& file_name);
+
+	bool node_timing_enabled () const {
+		return _timing_enabled.load () != 0;
+	}
+
 protected:
 	virtual void session_going_away ();
 
@@ -105,8 +152,30 @@ private:
 
 	void helper_thread ();
 
+	bool pop_work (ProcessNode*&);
+	bool pop_shared (ProcessNode*&);
+	void queue_shared (ProcessNode*, int priority);
+	void setup_thread_deques (uint32_t n_threads);
+	void drop_thread_deques ();
+
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
-	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
+	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue and all deques
+
+	/** nodes that can be processed and are on or close to the critical path,
+	 * indexed by priority - 1. These are dispatched before the _trigger_queue.
+	 */
+	PBD::MPMCQueue<ProcessNode*> _priority_queue[GraphChain::n_priority_levels - 1];
+
+	/** Per thread work-stealing deques, indexed by priority, then by process-thread
+	 * slot (0: main thread). A node that is triggered by a graph-thread is queued on
+	 * that thread's deque, and will be picked up by the same thread (while its inputs
+	 * are still in the CPU cache), unless an idle thread steals it first. Nodes of a
+	 * higher priority, on any deque or shared queue, are dispatched first.
+	 */
+	std::vector<PBD::WSDeque<ProcessNode*>*> _thread_deques[GraphChain::n_priority_levels];
+
+	/** use per thread deques for the current cycle, cached from Config in prep () */
+	bool _work_stealing;
 
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
@@ -145,6 +214,17 @@ private:
 	int  _process_retval;
 	bool _process_need_butler;
 
+	/* per node timing */
+	void record_node_timing (GraphNode const*, PBD::microseconds_t start);
+
+	std::atomic<int>                                 _timing_enabled;
+	std::atomic<uint32_t>                            _timing_dropped;
+	std::vector<PBD::RingBuffer<GraphNodeTiming>*> _timing_rb; ///< one per process-thread slot
+	std::vector<GraphNodeTiming>                     _timing_log;
+	Glib::Threads::Mutex                             _timing_lock;
+	uint64_t                                         _cycle_cnt;
+	samplepos_t                                      _cycle_cnt_start;
+
 	/* engine / thread connection */
 	PBD::ScopedConnectionList engine_connections;
 	void                      engine_stopped ();
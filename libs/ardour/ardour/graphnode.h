@@ -26,6 +26,7 @@
 #include <memory>
 #include <set>
 
+#include "pbd/microseconds.h"
 #include "pbd/rcu.h"
 
 #include "ardour/libardour_visibility.h"
@@ -59,6 +60,7 @@ public:
 
 	node_set_t const& activation_set (GraphChain const* const g) const;
 	int               init_refcount (GraphChain const* const g) const;
+	int               graph_priority (GraphChain const* const g) const;
 	void              flush_graph_activision_rcu ();
 
 protected:
@@ -68,6 +70,8 @@ protected:
 	SerializedRCUManager<ActivationMap> _activation_set;
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	SerializedRCUManager<RefCntMap> _init_refcount;
+	/** Dispatch priority, derived from the critical path length (one for each chain) */
+	SerializedRCUManager<RefCntMap> _graph_priority;
 };
 
 /** A node on our processing graph, ie a Route */
@@ -83,8 +87,16 @@ public:
 	/* API used to sort Nodes and create GraphChain */
 	virtual std::string graph_node_name () const = 0;
 
+	/** Estimated processing cost of this node in microseconds,
+	 * used to prioritize nodes on the critical path.
+	 */
+	virtual double graph_node_cost () const { return 1.0; }
+
 	virtual bool direct_feeds_according_to_reality (std::shared_ptr<GraphNode>, bool* via_send_only = 0) = 0;
 
+	/** time when the node became ready in the current cycle, only valid when node-timing is enabled */
+	PBD::microseconds_t queued_at () const { return _queued_at; }
+
 protected:
 	void trigger ();
 	virtual void process () = 0;
@@ -95,6 +107,10 @@ private:
 	void finish (GraphChain const*);
 
 	std::atomic<int> _refcount;
+	int              _priority; ///< cached graph_priority() of the current chain
+
+	PBD::microseconds_t _queued_at;
+
 };
 
 } // namespace ARDOUR
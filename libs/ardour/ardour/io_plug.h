@@ -106,6 +106,7 @@ public:
 		return name ();
 	}
 	bool direct_feeds_according_to_reality (std::shared_ptr<GraphNode>, bool* via_send_only = 0);
+	double graph_node_cost () const;
 	void process ();
 
 protected:
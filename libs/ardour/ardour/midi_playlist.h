@@ -24,9 +24,15 @@
 
 #include <vector>
 #include <list>
+#include <map>
+#include <memory>
+
+#include <glibmm/threads.h>
 
 #include "evoral/Parameter.h"
 
+#include "temporal/tempo.h"
+
 #include "ardour/ardour.h"
 #include "ardour/midi_cursor.h"
 #include "ardour/midi_model.h"
@@ -38,6 +44,7 @@
 
 namespace Evoral {
 template<typename Time> class EventSink;
+template<typename Time> class EventList;
 class                         Beats;
 }
 
@@ -86,9 +93,34 @@ public:
   private:
 	void dump () const;
 
+	/* Events of a region as last rendered, and the state they were rendered for */
+	struct RenderedRegion {
+		std::shared_ptr<MidiRegion>   region;
+		uint64_t                      generation;
+		timepos_t                     position;
+		timepos_t                     start;
+		timecnt_t                     length;
+		layer_t                       layer;
+		std::shared_ptr<RTMidiBuffer> events;
+		samplepos_t                   first; ///< time of the earliest event
+		samplepos_t                   last;  ///< time of the latest event
+	};
+
+	typedef std::map<MidiRegion const*, RenderedRegion> RenderCache;
+
+	void copy_rendered (std::shared_ptr<MidiRegion> const&, Evoral::EventList<samplepos_t>&, samplepos_t start, samplepos_t end) const;
+
 	NoteMode     _note_mode;
 
 	RTMidiBuffer _rendered;
+
+	Glib::Threads::Mutex          _render_lock;
+	RenderCache                   _render_cache;
+	bool                          _render_layered;
+	Temporal::TempoMap::SharedPtr _render_tempo_map;
+	MidiChannelFilter*            _render_filter;
+	uint32_t                      _render_filter_mode_mask;
+	NoteMode                      _render_note_mode;
 };
 
 } /* namespace ARDOUR */
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "temporal/beats.h"
@@ -122,6 +123,12 @@ class LIBARDOUR_API MidiRegion : public Region
 	void start_domain_bounce (Temporal::DomainBounceInfo&);
 	void finish_domain_bounce (Temporal::DomainBounceInfo&);
 
+	/** @return a counter that changes whenever the output of render() may
+	 * change for reasons other than region position, start, length or the
+	 * tempo map (e.g. model edits, or parameters being filtered).
+	 */
+	uint64_t render_generation () const { return _render_generation.load (); }
+
   protected:
 
 	virtual bool can_trim_start_before_source_start () const {
@@ -164,6 +171,7 @@ class LIBARDOUR_API MidiRegion : public Region
 	PBD::ScopedConnection _source_connection;
 	PBD::ScopedConnection _model_contents_connection;
 	bool _ignore_shift;
+	std::atomic<uint64_t> _render_generation;
 };
 
 } /* namespace ARDOUR */
@@ -34,6 +34,12 @@ extern "C" {
 
 LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
 
+LIBARDOUR_API void  x86_sse_apply_gain_vector_to_buffer  (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_mix_buffers_with_gain_vector (float* dst, float const* src, float const* gain, uint32_t nframes);
+LIBARDOUR_API float x86_sse_sum_of_squares               (float const* buf, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_interleave_channel           (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  x86_sse_deinterleave_channel         (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+
 extern "C" {
 /* AVX functions */
 	LIBARDOUR_API float x86_sse_avx_compute_peak          (float const* buf, uint32_t nsamples, float current);
@@ -49,6 +55,10 @@ extern "C" {
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
 
+LIBARDOUR_API void  x86_sse_avx_apply_gain_vector_to_buffer  (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_mix_buffers_with_gain_vector (float* dst, float const* src, float const* gain, uint32_t nframes);
+LIBARDOUR_API float x86_sse_avx_sum_of_squares               (float const* buf, uint32_t nframes);
+
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
@@ -62,6 +72,9 @@ LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const
 LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API void  x86_avx512f_apply_gain_vector_to_buffer  (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain_vector (float* dst, float const* src, float const* gain, uint32_t nframes);
+LIBARDOUR_API float x86_avx512f_sum_of_squares               (float const* buf, uint32_t nframes);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -81,6 +94,9 @@ LIBARDOUR_API void  veclib_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDOU
 LIBARDOUR_API void  veclib_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  veclib_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  veclib_find_peaks                (ARDOUR::Sample const* buf, ARDOUR::pframes_t nsamples, float* min, float* max);
+LIBARDOUR_API void  veclib_apply_gain_vector_to_buffer  (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  veclib_mix_buffers_with_gain_vector (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float veclib_sum_of_squares               (ARDOUR::Sample const* buf, ARDOUR::pframes_t nframes);
 
 #endif
 
@@ -94,6 +110,12 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
 }
+
+LIBARDOUR_API void  arm_neon_apply_gain_vector_to_buffer  (float* buf, float const* gain, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_mix_buffers_with_gain_vector (float* dst, float const* src, float const* gain, uint32_t nframes);
+LIBARDOUR_API float arm_neon_sum_of_squares               (float const* buf, uint32_t nframes);
+LIBARDOUR_API void  arm_neon_interleave_channel           (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  arm_neon_deinterleave_channel         (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
 #endif
 
 /* non-optimized functions */
@@ -104,4 +126,9 @@ LIBARDOUR_API void  default_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDO
 LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_apply_gain_vector_to_buffer  (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_mix_buffers_with_gain_vector (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float default_sum_of_squares               (ARDOUR::Sample const* buf, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_interleave_channel           (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  default_deinterleave_channel         (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t channel, uint32_t n_channels);
 
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Multi-resolution peak data of an AudioSource.
+ *
+ * The peakfile of a source holds one PeakData for every `samples_per_peak`
+ * samples. The pyramid file holds reductions of that by 4, 16, 64 .. 4^n_levels,
+ * so that peaks at any zoom level can be read in O(pixels).
+ *
+ * The file starts with a versioned header, followed by blocks that each
+ * cover `block_peaks` peakfile peaks and contain all levels for that range.
+ * This allows the file to grow while recording, without re-arranging data.
+ * Values are stored in native byte-order, as in the peakfile.
+ *
+ * A pyramid is an optional cache. If it is missing, outdated or of a
+ * different version, the peakfile is used and the pyramid re-built from it.
+ */
+class LIBARDOUR_API PeakPyramid
+{
+public:
+	static const uint32_t version  = 1;
+	static const uint32_t factor   = 4;
+	static const uint32_t n_levels = 8;
+
+	PeakPyramid (std::string const& path, samplecnt_t samples_per_peak);
+	~PeakPyramid ();
+
+	/* writing, _lock of the AudioSource must be held */
+
+	int  open ();
+	void close ();
+
+	/** add peakfile peaks, starting with peak number \p first
+	 * (i.e. the peak of samples [first * samples_per_peak, ...).
+	 * Data that does not follow previously added peaks invalidates
+	 * the pyramid, unless it starts over at zero.
+	 */
+	int append (PeakData const* peaks, size_t n, uint64_t first);
+
+	/** add partially accumulated peaks, and mark the pyramid as complete.
+	 * If data was written out of order, the pyramid is rebuilt from
+	 * \p peakfile
+	 */
+	int finish (std::string const& peakfile);
+
+	/** (re)build the pyramid file at \p path from \p peakfile */
+	static int build (std::string const& path, std::string const& peakfile, samplecnt_t samples_per_peak);
+
+	/** @return true if the pyramid at \p path is of this version and not older than \p peakfile */
+	static bool usable (std::string const& path, std::string const& peakfile, samplecnt_t samples_per_peak);
+
+	/** read \p npeaks visual peaks for \p cnt samples starting at \p start.
+	 * @return 0 on success, 1 if the pyramid cannot be used for the given
+	 * resolution or range, -1 on error.
+	 */
+	static int read_peaks (std::string const& path, samplecnt_t samples_per_peak,
+	                       PeakData* peaks, samplecnt_t npeaks,
+	                       samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak);
+
+private:
+	struct Header {
+		char     magic[8];
+		uint32_t version;
+		uint32_t samples_per_peak;
+		uint32_t factor;
+		uint32_t n_levels;
+		uint32_t block_peaks;
+		uint32_t complete;
+		uint64_t n_peaks; /* peakfile peaks folded into all levels */
+		char     reserved[24];
+	};
+
+	struct Accumulator {
+		PeakData peak;
+		uint32_t cnt;
+	};
+
+	static const uint64_t block_peaks = 65536; /* factor ^ n_levels */
+
+	static void     init_header (Header&, samplecnt_t samples_per_peak);
+	static bool     check_header (Header const&, samplecnt_t samples_per_peak);
+	static uint64_t level_peaks (uint32_t level) { return (uint64_t)1 << (2 * level); }
+	static off_t    level_offset (uint32_t level, uint64_t index);
+
+	int  reset ();
+	void add (uint32_t level, PeakData const&);
+	int  flush ();
+	int  write_header ();
+	int  write_at (off_t, void const*, size_t);
+
+	std::string _path;
+	samplecnt_t _samples_per_peak;
+	int         _fd;
+	bool        _broken;
+	Header      _header;
+
+	Accumulator _acc[n_levels + 1];
+	uint64_t    _next[n_levels + 1];                 /* index of the next entry per level */
+	std::vector<PeakData> _pending[n_levels + 1];    /* entries not yet written */
+	uint64_t    _pending_start[n_levels + 1];
+};
+
+} // namespace ARDOUR
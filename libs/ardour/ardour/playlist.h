@@ -49,6 +49,7 @@
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
 #include "ardour/region.h"
+#include "ardour/region_index.h"
 #include "ardour/session_object.h"
 #include "ardour/thawlist.h"
 
@@ -220,6 +221,14 @@ public:
 	 *  @return regions which have some part within this range.
 	 */
 	std::shared_ptr<RegionList> regions_touched (timepos_t const & start, timepos_t const & end);
+
+	/* Allocation free variants of regions_at() and regions_touched().
+	 * The given vector is cleared and filled with the result, it is
+	 * meant to be re-used by the caller to avoid allocations.
+	 */
+	void collect_regions_at (timepos_t const & pos, RegionVector& result);
+	void collect_regions_touched (timepos_t const & start, timepos_t const & end, RegionVector& result, bool with_tail = false);
+
 	std::shared_ptr<RegionList> regions_with_start_within (Temporal::TimeRange);
 	std::shared_ptr<RegionList> regions_with_end_within (Temporal::TimeRange);
 	std::shared_ptr<RegionList> audible_regions_at (timepos_t const &);
@@ -324,6 +333,7 @@ protected:
 		    , playlist (pl)
 		    , block_notify (do_block_notify)
 		{
+			playlist->_region_index.suspend ();
 			if (block_notify) {
 				playlist->delay_notifications ();
 			}
@@ -331,6 +341,7 @@ protected:
 
 		~RegionWriteLock ()
 		{
+			playlist->_region_index.resume ();
 			Glib::Threads::RWLock::WriterLock::release ();
 			thawlist.release ();
 			if (block_notify) {
@@ -344,6 +355,7 @@ protected:
 	};
 
 	RegionListProperty                   regions;     /* the current list of regions in the playlist */
+	RegionIndex                          _region_index; /* interval index of `regions` */
 	std::set<std::shared_ptr<Region> > all_regions; /* all regions ever added to this playlist */
 	PBD::ScopedConnectionList            region_state_changed_connections;
 	PBD::ScopedConnectionList            region_drop_references_connections;
@@ -401,6 +413,7 @@ protected:
 	void _set_sort_id ();
 
 	std::shared_ptr<RegionList> regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail);
+	void collect_regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail, RegionVector& result);
 
 	void notify_region_removed (std::shared_ptr<Region>);
 	void notify_region_added (std::shared_ptr<Region>);
@@ -95,6 +95,12 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 
 	virtual void* get_buffer (pframes_t nframes) = 0;
 
+	/** @return the data of an audio output port, which is summed by
+	 * connected input ports. The pointer must be valid for the
+	 * lifetime of the port.
+	 */
+	virtual Sample const* source_buffer () const { return 0; }
+
 	const LatencyRange latency_range (bool for_playback) const
 	{
 		return for_playback ? _playback_latency_range : _capture_latency_range;
@@ -107,6 +113,17 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 protected:
 	PortEngineSharedImpl& _backend;
 
+	/** sum the data of all connected ports into \p dst (audio input ports only).
+	 * If all connected ports are physical inputs, this is done at most
+	 * once per process cycle, see PortEngineSharedImpl::next_process_cycle ()
+	 */
+	void mix_connections (Sample* dst, pframes_t n_samples);
+
+	/** @return true if the port's data is only produced on demand by
+	 * calling get_buffer (), when it is used as source of a connection.
+	 */
+	virtual bool generates_data () const { return false; }
+
 private:
 	std::string            _name;
 	std::string            _pretty_name;
@@ -116,8 +133,23 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	/* flat copy of _connections, for use in the process thread */
+	struct Source {
+		BackendPort*  port;
+		Sample const* data;
+		bool          generate;
+		bool          physical;
+	};
+
+	typedef std::vector<Source> Sources;
+
+	SerializedRCUManager<Sources> _sources;
+	uint64_t                      _mixed_cycle;
+	pframes_t                     _mixed_samples;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_sources ();
 
 }; // class BackendPort
 
@@ -204,6 +236,16 @@ protected:
 
 	void process_connection_queue_locked (PortManager& mgr);
 
+	/* to be called by backends at the start of every process cycle,
+	 * before calling into the engine */
+	void next_process_cycle () {
+		if (++_process_cycle == 0) {
+			++_process_cycle; /* 0 = not counting, see BackendPort::mix_connections */
+		}
+	}
+
+	uint64_t _process_cycle;
+
 	void port_connect_add_remove_callback () {
 		_port_change_flag.store (1);
 	}
@@ -38,6 +38,7 @@
 
 namespace ARDOUR {
 
+class AudioPort;
 class PortEngine;
 class AudioBackend;
 class Session;
@@ -285,8 +286,35 @@ protected:
 	std::shared_ptr<Port> register_port (DataType type, const std::string& portname, bool input, bool async = false, PortFlags extra_flags = PortFlags (0));
 	void                    port_registration_failure (const std::string& portname);
 
+	typedef std::vector<std::shared_ptr<Port> > CyclePorts;
+
 	/** List of ports to be used between \ref cycle_start() and \ref cycle_end() */
-	std::shared_ptr<Ports const> _cycle_ports;
+	std::shared_ptr<CyclePorts const> _cycle_ports;
+
+	/** Flat copy of \ref _ports, updated whenever ports are added, removed or renamed */
+	SerializedRCUManager<CyclePorts> _cycle_port_list;
+	void update_cycle_ports ();
+
+	/** release backend port-handles of physical and shared inputs, before the backend is stopped or dropped */
+	void drop_input_handles ();
+
+	/** Resampler of an external port, shared by all input ports
+	 * that are only connected to that port
+	 */
+	class SharedInput;
+
+	struct SharedInputPorts {
+		std::shared_ptr<SharedInput>             input;
+		std::vector<std::shared_ptr<AudioPort> > ports;
+	};
+
+	typedef std::vector<SharedInputPorts> SharedInputs;
+
+	/** List of shared inputs to be used between \ref cycle_start() and \ref cycle_end() */
+	std::shared_ptr<SharedInputs const> _cycle_shared_inputs;
+
+	SerializedRCUManager<SharedInputs> _shared_inputs;
+	void update_shared_input (std::shared_ptr<Port> const&);
 
 	void silence (pframes_t nframes, Session* s = 0);
 	void silence_outputs (pframes_t nframes);
@@ -387,6 +415,15 @@ private:
 
 	SerializedRCUManager<AudioInputPorts> _audio_input_ports;
 	SerializedRCUManager<MIDIInputPorts>  _midi_input_ports;
+
+	/* backend port-handles of the above, resolved when ports are (un)registered */
+	typedef std::vector<std::pair<PortEngine::PortPtr, AudioInputPort> > AudioInputHandles;
+	typedef std::vector<std::pair<PortEngine::PortPtr, MIDIInputPort> >  MIDIInputHandles;
+
+	SerializedRCUManager<AudioInputHandles> _audio_input_handles;
+	SerializedRCUManager<MIDIInputHandles>  _midi_input_handles;
+	void update_input_handles ();
+
 	std::atomic<int>                     _reset_meters;
 };
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Record the duration of a given number of process cycles.
+ *
+ * This is intended to measure the performance of a session, e.g. with
+ * the Dummy backend running as fast as possible (driver "Benchmark"),
+ * without audio hardware.
+ *
+ * A cycle that takes longer than the nominal duration of a period is
+ * counted as xrun, since it could not have been processed in realtime.
+ *
+ * Without pacing, disk i/o may not keep up with playback. Disk reader
+ * underruns during the benchmark are counted, since cycles that play
+ * silence are not representative.
+ */
+class LIBARDOUR_API ProcessBenchmark
+{
+public:
+	ProcessBenchmark ();
+
+	/** prepare to record the next \p n_cycles process cycles.
+	 * Must not be called concurrently with processing.
+	 */
+	void start (uint32_t n_cycles, pframes_t samples_per_cycle, samplecnt_t sample_rate);
+
+	/** abort recording, and discard collected data */
+	void reset ();
+
+	bool running () const { return _running.load (); }
+	bool done () const;
+
+	/** realtime context: note a disk reader underrun */
+	void underrun ();
+	uint32_t underruns () const { return _underruns.load (); }
+
+	/** @return statistics of the recorded cycles as JSON object */
+	std::string report () const;
+
+	/** Time the scope of a process cycle, if a benchmark is running */
+	class LIBARDOUR_API Cycle
+	{
+	public:
+		Cycle (ProcessBenchmark& b)
+			: _b (b)
+			, _start (b.running () ? PBD::get_microseconds () : 0)
+		{}
+
+		~Cycle ()
+		{
+			if (_start > 0) {
+				_b.record (_start, PBD::get_microseconds ());
+			}
+		}
+
+	private:
+		ProcessBenchmark&    _b;
+		PBD::microseconds_t _start;
+	};
+
+private:
+	void record (PBD::microseconds_t start, PBD::microseconds_t end);
+
+	std::vector<PBD::microseconds_t> _cycles;
+	std::atomic<uint32_t>            _n_recorded;
+	std::atomic<uint32_t>            _underruns;
+	std::atomic<bool>                _running;
+
+	pframes_t           _samples_per_cycle;
+	samplecnt_t         _sample_rate;
+	PBD::microseconds_t _first_start;
+	PBD::microseconds_t _last_end;
+};
+
+} // namespace ARDOUR
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "temporal/range.h"
+#include "temporal/timeline.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Interval index of the regions of a Playlist.
+ *
+ * Regions are kept in a vector sorted by position, which doubles as an
+ * implicit balanced binary search tree whose nodes are annotated with
+ * the largest end-position in their subtree (an augmented interval tree).
+ * Stabbing and overlap queries are O(log n + k), start/end range
+ * queries are a binary search.
+ *
+ * The index is owned by the Playlist, and refers to the elements of its
+ * RegionList. It is invalidated by any change to the list or to the bounds
+ * of a region, and lazily rebuilt on the next query. While the playlist's
+ * write-lock is held the index is suspended, since regions are added, moved
+ * and removed in batches, and the caller has to fall back to a linear search.
+ *
+ * All queries require that the caller holds the playlist's region lock.
+ * They return false if the index cannot be used, otherwise matching regions
+ * are appended to @p result in the same order as they appear in @p regions.
+ */
+class LIBARDOUR_API RegionIndex
+{
+public:
+	RegionIndex ();
+
+	void invalidate () {
+		_dirty.store (true);
+	}
+
+	void suspend ();
+	void resume ();
+
+	bool regions_at (RegionList const& regions, Temporal::timepos_t const& pos, RegionList& result);
+	bool regions_at (RegionList const& regions, Temporal::timepos_t const& pos, RegionVector& result);
+	bool regions_touched (RegionList const& regions, Temporal::timepos_t const& start, Temporal::timepos_t const& end, bool with_tail, RegionList& result);
+	bool regions_touched (RegionList const& regions, Temporal::timepos_t const& start, Temporal::timepos_t const& end, bool with_tail, RegionVector& result);
+	bool regions_with_start_within (RegionList const& regions, Temporal::TimeRange const& range, RegionList& result);
+	bool regions_with_end_within (RegionList const& regions, Temporal::TimeRange const& range, RegionList& result);
+
+	/* below this size a linear search is cheaper */
+	static const size_t min_regions = 32;
+
+private:
+	struct Entry {
+		int64_t  start;
+		int64_t  last;
+		int64_t  max_last; /* max. `last` of the implicit subtree rooted at this entry */
+		uint32_t order;    /* position in the RegionList */
+		bool     tail;     /* region may have a tail beyond its `last` */
+
+		std::shared_ptr<Region> const* region;
+	};
+
+	bool    prepare (RegionList const&);
+	void    rebuild (RegionList const&);
+	int64_t annotate (size_t lo, size_t hi);
+	void    find_overlapping (size_t lo, size_t hi, int64_t start, int64_t last, bool skip_tail);
+	bool    find_at (RegionList const&, Temporal::timepos_t const&);
+	bool    find_touched (RegionList const&, Temporal::timepos_t const&, Temporal::timepos_t const&, bool with_tail);
+
+	/* append _hits to result, in RegionList order */
+	template <typename C>
+	void collect (C& result)
+	{
+		std::sort (_hits.begin (), _hits.end (), [] (Entry const* a, Entry const* b) {
+			return a->order < b->order;
+		});
+		for (auto const& e : _hits) {
+			result.push_back (*e->region);
+		}
+		_hits.clear ();
+	}
+
+	int64_t key (Temporal::timepos_t const& t) const {
+		return _beat_time ? t.ticks () : t.superclocks ();
+	}
+
+	Glib::Threads::Mutex _lock;
+	std::atomic<bool>    _dirty;
+	std::atomic<int>     _suspended;
+	bool                 _beat_time;
+
+	std::vector<Entry>        _by_start;
+	std::vector<Entry const*> _by_last;
+	std::vector<Entry const*> _with_tail;
+	std::vector<Entry const*> _hits;
+};
+
+} // namespace ARDOUR
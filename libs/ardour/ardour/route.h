@@ -458,6 +458,8 @@ public:
 		return name ();
 	}
 
+	double graph_node_cost () const;
+
 	/**
 	 * @return true if this route feeds the first argument directly, via
 	 * either its main outs or a send, according to the graph that
@@ -48,6 +48,13 @@ class LIBARDOUR_API RTMidiBufferBase : public Evoral::EventSink<TimeType>
 		uint8_t data[0];
 	};
 
+	/* An Item refers to data (more than 3 bytes) in the pool by setting
+	 * the LSbit of its offset, so that bytes[0] is non-zero (this assumes
+	 * a little-endian host, as does the inline storage).
+	 */
+	static uint32_t blob_ref (uint32_t offset) { return (offset << 1) | 1; }
+	static uint32_t blob_offset (uint32_t ref) { return ref >> 1; }
+
   public:
 	RTMidiBufferBase ();
 	~RTMidiBufferBase ();
@@ -66,6 +73,16 @@ class LIBARDOUR_API RTMidiBufferBase : public Evoral::EventSink<TimeType>
 	DistanceType span() const;
 
 	uint32_t write (TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
+
+	/** append the events of \p src with timestamps in [start, end).
+	 * \p src must be sorted by time, and not reversed.
+	 */
+	void append (RTMidiBufferBase const& src, TimeType start, TimeType end);
+
+	/** exchange the contents of this buffer with \p other.
+	 * Callers must hold a WriteProtectRender of either buffer that may be in use.
+	 */
+	void swap (RTMidiBufferBase& other);
 	uint32_t read (MidiBuffer& dst, TimeType start, TimeType end, MidiNoteTracker& tracker, DistanceType offset = 0);
 	void track (MidiStateTracker&, TimeType start, TimeType end);
 
@@ -93,7 +110,7 @@ class LIBARDOUR_API RTMidiBufferBase : public Evoral::EventSink<TimeType>
 			size = Evoral::midi_event_size (item.bytes[1]);
 			return &item.bytes[1];
 		} else {
-			uint32_t offset = item.offset & ~(1<<(CHAR_BIT-1));
+			uint32_t offset = blob_offset (item.offset);
 			Blob* blob = reinterpret_cast<Blob*> (&_pool[offset]);
 
 			size = blob->size;
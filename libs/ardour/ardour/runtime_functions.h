@@ -30,6 +30,11 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*apply_gain_vector_to_buffer_t)  (ARDOUR::Sample *, const ARDOUR::gain_t *, pframes_t);
+	typedef void  (*mix_buffers_with_gain_vector_t) (ARDOUR::Sample *, const ARDOUR::Sample *, const ARDOUR::gain_t *, pframes_t);
+	typedef float (*sum_of_squares_t)               (const ARDOUR::Sample *, pframes_t);
+	typedef void  (*interleave_channel_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t, uint32_t);
+	typedef void  (*deinterleave_channel_t)         (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t, uint32_t);
 
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
@@ -37,5 +42,15 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+
+	/** multiply each sample with the corresponding gain coefficient, e.g. a gain-ramp */
+	LIBARDOUR_API extern apply_gain_vector_to_buffer_t  apply_gain_vector_to_buffer;
+	/** dst[i] += src[i] * gain[i] */
+	LIBARDOUR_API extern mix_buffers_with_gain_vector_t mix_buffers_with_gain_vector;
+	LIBARDOUR_API extern sum_of_squares_t               sum_of_squares;
+	/** copy a mono buffer into the given channel of an interleaved buffer: (dst, src, nframes, channel, n_channels) */
+	LIBARDOUR_API extern interleave_channel_t           interleave_channel;
+	/** copy the given channel of an interleaved buffer into a mono buffer: (dst, src, nframes, channel, n_channels) */
+	LIBARDOUR_API extern deinterleave_channel_t         deinterleave_channel;
 }
 
@@ -360,6 +360,14 @@ public:
 
 	bool plot_process_graph (std::string const& file_name) const;
 
+	/** update process graph priorities from measured DSP load, at most once a second */
+	void refresh_process_graph_priorities ();
+
+	void start_process_graph_timing ();
+	void stop_process_graph_timing ();
+	size_t collect_process_graph_timing ();
+	bool write_process_graph_timing (std::string const& file_name);
+
 	std::shared_ptr<BundleList const> bundles () {
 		return _bundles.reader ();
 	}
@@ -1992,6 +2000,7 @@ private:
 	SourceMap sources;
 
 	int load_sources (const XMLNode& node);
+	void prefetch_sources (const XMLNode& node);
 	XMLNode& get_sources_as_xml ();
 
 	std::shared_ptr<Source> XMLSourceFactory (const XMLNode&);
@@ -2268,6 +2277,7 @@ private:
 	std::shared_ptr<Graph>      _process_graph;
 	std::shared_ptr<GraphChain> _graph_chain;
 	std::shared_ptr<GraphChain> _io_graph_chain[2];
+	int64_t                     _graph_priorities_refreshed;
 
 	void resort_routes_using (std::shared_ptr<RouteList>);
 	void resort_io_plugs ();
@@ -24,8 +24,12 @@
 
 #pragma once
 
+#include <map>
+
 #include <sndfile.h>
 
+#include <glibmm/threads.h>
+
 #include "ardour/audiofilesource.h"
 #include "ardour/broadcast_info.h"
 
@@ -76,6 +80,16 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	static int get_soundfile_info (const std::string& path, SoundFileInfo& _info, std::string& error_msg);
 
+	/** Open and parse the given file for reading. The next read-only source
+	 * that is created for this path takes over the open handle.
+	 * This is thread-safe, and used to open session files in parallel.
+	 * @return true if the file is a valid sound file
+	 */
+	static bool prefetch (const std::string& path);
+
+	/** close handles that were prefetched but not used by any source */
+	static void drop_prefetched ();
+
   protected:
 	void close ();
 
@@ -91,6 +105,46 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* deinterleaved data of the most recent read, shared by all
+	 * sources that read a channel of the same multi-channel file
+	 */
+	struct SharedReadCache;
+	std::shared_ptr<SharedReadCache> _read_cache;
+
+	void attach_read_cache ();
+	samplecnt_t read_cached (Sample* dst, samplepos_t start, samplecnt_t cnt) const;
+
+	/* read-ahead hints for sequential reads of uncompressed files */
+	int                 _fd;
+	off_t               _data_offset;
+	uint32_t            _bytes_per_frame; // 0: not applicable
+	mutable samplepos_t _last_read_end;
+
+	void setup_read_ahead (int fd);
+	void read_ahead (samplepos_t start, samplecnt_t cnt) const;
+
+	/* preallocation and bounded write-behind for capture files */
+	int   _write_fd;        // -1: not used
+	off_t _write_allocated; // end of preallocated space, -1: not supported
+	off_t _write_started;   // start of the range that is being written back
+	off_t _write_done;      // data before this is on disk and dropped from the page cache
+	bool  _write_bounded;   // capture-write-behind: wait for written data and drop it from the page cache
+
+	void setup_write_behind (int fd);
+	void write_behind ();
+	void finish_write_behind ();
+
+	struct Prefetched {
+		int      fd;
+		SNDFILE* sndfile;
+		SF_INFO  info;
+	};
+
+	static Glib::Threads::Mutex                    _prefetch_lock;
+	static std::multimap<std::string, Prefetched> _prefetched;
+
+	bool take_prefetched (int& fd);
+
 	void init_sndfile ();
 	int open();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
@@ -22,6 +22,7 @@
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "pbd/pthread_utils.h"
 #include "ardour/source.h"
@@ -56,9 +57,15 @@ public:
 	static std::vector<PBD::Thread*> peak_thread_pool;
 
 	static std::list<std::weak_ptr<AudioSource>> files_with_peaks;
+	static size_t n_prioritized_peakfiles; // at the front of files_with_peaks
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (std::shared_ptr<Source>, bool async);
+
+	/** build peaks of the given sources (e.g. those visible in the editor) before other queued sources */
+	static void prioritize_peakfiles (std::vector<std::shared_ptr<AudioSource>> const&);
+	/** drop all queued peak building jobs and interrupt those in progress */
+	static void cancel_peak_building ();
 };
 
 } // namespace ARDOUR
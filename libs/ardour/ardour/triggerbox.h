@@ -69,6 +69,7 @@ namespace MIDI {
 namespace ARDOUR {
 
 class Session;
+class AudioClipStream;
 class AudioRegion;
 class MidiRegion;
 class TriggerBox;
@@ -566,8 +567,9 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	struct AudioData : std::vector<Sample*> {
 		samplecnt_t length;
 		samplecnt_t capacity;
+		bool        owned; /* false if the data belongs to the AudioClipCache or is streamed */
 
-		AudioData () : length (0), capacity (0) {}
+		AudioData () : length (0), capacity (0), owned (true) {}
 		~AudioData ();
 
 		samplecnt_t append (Sample const * src, samplecnt_t cnt, uint32_t chan);
@@ -578,11 +580,24 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	Sample const * audio_data (size_t n) const;
 	size_t data_length() const { return data.length; }
 
+	/* called from the TriggerBoxThread */
+	void render_stretch (double bpm, std::shared_ptr<AudioData const>);
+	void drop_render_trash ();
+	void drop_data_trash ();
+
   protected:
 	void retrigger ();
 
   private:
 	AudioData        data;
+	std::shared_ptr<AudioData const>  _shared_data; /* keeps shared `data` alive */
+	std::unique_ptr<AudioClipStream>  _stream;      /* used if `data` does not fit into memory */
+
+	/* the previous clip, when replaced by a capture in the process thread */
+	std::shared_ptr<AudioData const>  _shared_data_trash;
+	std::unique_ptr<AudioClipStream>  _stream_trash;
+	std::atomic<bool>                 _data_trash_pending; /* process thread -> worker */
+
 	RubberBand::RubberBandStretcher*  _stretcher;
 	samplepos_t _start_offset;
 
@@ -597,10 +612,50 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	samplecnt_t to_pad;
 	samplecnt_t to_drop;
 
+	/* Offline time-stretched copy of the clip, rendered by the
+	 * TriggerBoxThread for a given tempo. While it is not (yet)
+	 * available, the realtime stretcher is used.
+	 */
+	struct StretchRender {
+		StretchRender () : bpm (0), segment_tempo (0), mode (Trigger::Crisp), generation (0), length (0), bytes (0) {}
+		~StretchRender ();
+
+		double      bpm;
+		double      segment_tempo;
+		StretchMode mode;
+		uint64_t    generation; /* of the data it was rendered from */
+		samplecnt_t length;
+		int64_t     bytes;
+		std::vector<Sample*> data;
+	};
+
+	StretchRender*              _render;         /* used by the process thread */
+	std::atomic<StretchRender*> _pending_render; /* worker -> process thread */
+	std::atomic<StretchRender*> _render_trash;   /* process thread -> worker */
+	std::atomic<bool>           _render_requested;
+	std::atomic<double>         _render_failed_bpm; /* do not request again for this tempo */
+	std::atomic<uint64_t>       _data_generation;
+	bool                        _use_render;
+	bool                        _render_switch;  /* at a (re)start, may switch to the render */
+	samplepos_t                 _render_index;
+	samplepos_t                 _retrigger_index;
+	double                      _render_bpm;     /* to wait for a stable tempo */
+	uint32_t                    _render_bpm_cycles;
+
+	static const uint32_t render_stable_cycles = 16;
+
+	StretchRender* render (double bpm, AudioData const&) const;
+	bool render_usable (double bpm, uint32_t nchans) const;
+	void use_render (double bpm, uint32_t nchans);
+	int  render_available () const;
+	samplecnt_t render_retrieve (Sample* const* out, samplecnt_t cnt);
+	void invalidate_render ();
+
 	virtual void setup_stretcher ();
 
 	void drop_data ();
 	int load_data (std::shared_ptr<AudioRegion>);
+	Sample const* clip_data (uint32_t chn, samplepos_t pos, samplecnt_t cnt);
 	void estimate_tempo ();
 	void reset_stretcher ();
 	void _startup (BufferSet&, pframes_t dest_offset, Temporal::BBT_Offset const &);
@@ -608,6 +663,108 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 };
 
 
+/** Shared audio data of clips.
+ *
+ * Clips that use the same range of the same sources share one copy of the
+ * data, which is released when the last clip using it is unloaded.
+ * The total size is limited by the "clip-memory-megabytes" config
+ * variable. Clips that do not fit are streamed from disk instead.
+ */
+class LIBARDOUR_API AudioClipCache
+{
+  public:
+	/** @return the data of the given region, or an empty pointer if it does not fit into memory */
+	static std::shared_ptr<AudioTrigger::AudioData const> get (std::shared_ptr<AudioRegion>);
+
+	/** account for other clip data (e.g. pre-stretched audio).
+	 * @return false if it does not fit into memory
+	 */
+	static bool reserve (int64_t bytes);
+	static void unreserve (int64_t bytes) { _bytes.fetch_sub (bytes); }
+
+	static int64_t bytes () { return _bytes.load (); }
+
+  private:
+	static int64_t limit ();
+
+	struct Key {
+		std::vector<PBD::ID> sources;
+		samplepos_t          start;
+		samplecnt_t          length;
+
+		bool operator< (Key const&) const;
+	};
+
+	static void release (Key const&, AudioTrigger::AudioData const*, int64_t bytes);
+
+	static Glib::Threads::Mutex _lock;
+	static std::map<Key, std::weak_ptr<AudioTrigger::AudioData const> > _clips;
+	static std::atomic<int64_t> _bytes;
+};
+
+/** Audio data of a clip that is read from disk while it plays.
+ *
+ * The data is held in a few windows, which overlap by `max_read` samples,
+ * so that any read of up to that size is contiguous in memory. The window
+ * at the clip's start offset is retained for retriggering, the windows at
+ * and after the current read position are loaded by the butler.
+ *
+ * The windows are accounted for by the AudioClipCache. The constructor
+ * throws failed_constructor if they do not fit into the budget.
+ */
+class LIBARDOUR_API AudioClipStream
+{
+  public:
+	AudioClipStream (std::shared_ptr<AudioRegion>);
+	~AudioClipStream ();
+
+	static constexpr samplecnt_t max_read = 16384;
+
+	/** realtime context: @return `cnt` samples of channel `chn` at clip-relative
+	 * position `pos`, or silence if the data has not been loaded (yet).
+	 */
+	Sample const* read (uint32_t chn, samplepos_t pos, samplecnt_t cnt);
+
+	/** @return the first window of channel 0 if it is loaded, its length in `cnt` */
+	Sample const* head (samplecnt_t& cnt) const;
+
+	/** set the position that playback (re)starts from, and load it */
+	void set_anchor (samplepos_t pos, bool load_now);
+
+	bool refill_needed () const { return _refill_needed.load (); }
+
+	/** load windows that are needed for playback, called by the butler */
+	static void refill_all ();
+
+  private:
+	static constexpr samplecnt_t window_size = 262144; /* per channel */
+	static constexpr samplecnt_t stride      = window_size - max_read;
+	static constexpr uint32_t    n_windows   = 4;
+
+	struct Window {
+		std::atomic<int64_t>                    index; /* -1 while empty or being loaded */
+		std::vector<std::unique_ptr<Sample[]> > data;
+	};
+
+	Window const* find (int64_t index) const;
+	void          load (Window&, int64_t index);
+	void          refill ();
+	int64_t       bytes () const;
+
+	std::shared_ptr<AudioRegion> _region;
+	uint32_t                     _n_channels;
+	samplecnt_t                  _length;
+	int64_t                      _last_index;
+	Window                       _windows[n_windows];
+	std::unique_ptr<Sample[]>    _silence;
+	std::atomic<int64_t>         _position; /* window of the last read */
+	std::atomic<int64_t>         _anchor;   /* window of the start offset */
+	std::atomic<bool>            _refill_needed;
+
+	static Glib::Threads::Mutex          _streams_lock;
+	static std::vector<AudioClipStream*> _streams;
+};
+
 class LIBARDOUR_API MIDITrigger : public Trigger {
   public:
 	MIDITrigger (uint32_t index, TriggerBox&);
@@ -748,6 +905,9 @@ class LIBARDOUR_API TriggerBoxThread
 	void set_region (TriggerBox&, uint32_t slot, std::shared_ptr<Region>);
 	void request_delete_trigger (Trigger* t);
 	void request_build_source (Trigger* t, Temporal::timecnt_t const & duration);
+	void request_stretch_render (AudioTrigger* t, double bpm, std::shared_ptr<AudioTrigger::AudioData const>);
+	void request_drop_render (AudioTrigger* t);
+	void request_drop_data (AudioTrigger* t);
 
 	void summon();
 	void stop();
@@ -761,7 +921,10 @@ class LIBARDOUR_API TriggerBoxThread
 		Quit,
 		SetRegion,
 		DeleteTrigger,
-		BuildSourceAndRegion
+		BuildSourceAndRegion,
+		StretchRender,
+		DropStretchRender,
+		DropClipData
 	};
 
 	struct Request {
@@ -776,6 +939,9 @@ class LIBARDOUR_API TriggerBoxThread
 		/* for DeleteTrigger and BuildSourceAndRegion */
 		Trigger* trigger;
 		Temporal::timecnt_t duration;
+		/* for StretchRender */
+		double bpm;
+		std::shared_ptr<AudioTrigger::AudioData const> audio_data;
 
 		void* operator new (size_t);
 		void  operator delete (void* ptr, size_t);
@@ -855,6 +1021,11 @@ class LIBARDOUR_API TriggerBox : public Processor, public std::enable_shared_fro
 
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool result_required);
 	void run_cycle (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes);
+
+	/* set during run() by triggers that read their data from disk */
+	bool need_butler () const { return _need_butler; }
+	void set_need_butler () { _need_butler = true; }
+
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
 	bool configure_io (ChanCount in, ChanCount out);
 
@@ -995,6 +1166,7 @@ class LIBARDOUR_API TriggerBox : public Processor, public std::enable_shared_fro
 	int32_t _order;
 	mutable Glib::Threads::RWLock trigger_lock; /* protects all_triggers */
 	Triggers all_triggers;
+	bool     _need_butler;
 
 	typedef std::vector<Trigger*> PendingTriggers;
 	PendingTriggers pending;
@@ -515,4 +515,115 @@ arm_neon_copy_vector(
 	}
 }
 
+void
+arm_neon_apply_gain_vector_to_buffer (float* dst, const float* gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		float32x4_t x0 = vmulq_f32 (vld1q_f32 (dst + 0), vld1q_f32 (gain + 0));
+		float32x4_t x1 = vmulq_f32 (vld1q_f32 (dst + 4), vld1q_f32 (gain + 4));
+		vst1q_f32 (dst + 0, x0);
+		vst1q_f32 (dst + 4, x1);
+		dst += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ *= *gain++;
+		--nframes;
+	}
+}
+
+void
+arm_neon_mix_buffers_with_gain_vector (float* dst, const float* src, const float* gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		float32x4_t x0 = vmlaq_f32 (vld1q_f32 (dst + 0), vld1q_f32 (src + 0), vld1q_f32 (gain + 0));
+		float32x4_t x1 = vmlaq_f32 (vld1q_f32 (dst + 4), vld1q_f32 (src + 4), vld1q_f32 (gain + 4));
+		vst1q_f32 (dst + 0, x0);
+		vst1q_f32 (dst + 4, x1);
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+}
+
+float
+arm_neon_sum_of_squares (const float* src, uint32_t nframes)
+{
+	float32x4_t acc0 = vdupq_n_f32 (0.f);
+	float32x4_t acc1 = vdupq_n_f32 (0.f);
+
+	while (nframes >= 8) {
+		float32x4_t x0 = vld1q_f32 (src + 0);
+		float32x4_t x1 = vld1q_f32 (src + 4);
+		acc0 = vmlaq_f32 (acc0, x0, x0);
+		acc1 = vmlaq_f32 (acc1, x1, x1);
+		src += 8;
+		nframes -= 8;
+	}
+
+	acc0 = vaddq_f32 (acc0, acc1);
+	float32x2_t s = vadd_f32 (vget_low_f32 (acc0), vget_high_f32 (acc0));
+	s = vpadd_f32 (s, s);
+
+	float sum = vget_lane_f32 (s, 0);
+
+	while (nframes > 0) {
+		sum += *src * *src;
+		++src;
+		--nframes;
+	}
+	return sum;
+}
+
+void
+arm_neon_interleave_channel (float* dst, const float* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 2) {
+		while (nframes >= 4) {
+			float32x4x2_t d = vld2q_f32 (dst);
+			d.val[channel] = vld1q_f32 (src);
+			vst2q_f32 (dst, d);
+			src += 4;
+			dst += 8;
+			nframes -= 4;
+		}
+	}
+
+	dst += channel;
+	while (nframes > 0) {
+		*dst = *src++;
+		dst += n_channels;
+		--nframes;
+	}
+}
+
+void
+arm_neon_deinterleave_channel (float* dst, const float* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 2) {
+		while (nframes >= 4) {
+			float32x4x2_t s = vld2q_f32 (src);
+			vst1q_f32 (dst, s.val[channel]);
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	}
+
+	src += channel;
+	while (nframes > 0) {
+		*dst++ = *src;
+		src += n_channels;
+		--nframes;
+	}
+}
+
 #endif
@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <deque>
 
 #include <cstdlib>
 
@@ -152,7 +153,7 @@ AudioPlaylist::AudioPlaylist (std::shared_ptr<const AudioPlaylist> other, timepo
 
 /** Sort by descending layer and then by ascending position */
 struct ReadSorter {
-    bool operator() (std::shared_ptr<Region> a, std::shared_ptr<Region> b) {
+    bool operator() (std::shared_ptr<Region> const& a, std::shared_ptr<Region> const& b) const {
 	    if (a->layer() != b->layer()) {
 		    return a->layer() > b->layer();
 	    }
@@ -169,6 +170,48 @@ struct Segment {
 	Temporal::Range range;       ///< range of the region to read, in session samples
 };
 
+/** Per-thread scratch lists for AudioPlaylist::read.
+ *
+ * Reading a compound region recurses into the read of its nested playlist
+ * (via AudioPlaylistSource), so there is one set of lists per recursion depth.
+ */
+class ReadScratch {
+public:
+	ReadScratch ()
+	{
+		if (_stack.size () <= _depth) {
+			_stack.emplace_back ();
+		}
+		_lists = &_stack[_depth++];
+	}
+
+	~ReadScratch ()
+	{
+		/* do not hold references to the regions */
+		_lists->all.clear ();
+		_lists->to_do.clear ();
+		--_depth;
+	}
+
+	RegionVector&    all ()   { return _lists->all; }
+	vector<Segment>& to_do () { return _lists->to_do; }
+
+private:
+	struct Lists {
+		RegionVector    all;
+		vector<Segment> to_do;
+	};
+
+	Lists* _lists;
+
+	/* a deque does not move its elements when growing */
+	static thread_local std::deque<Lists> _stack;
+	static thread_local size_t            _depth;
+};
+
+thread_local std::deque<ReadScratch::Lists> ReadScratch::_stack;
+thread_local size_t                         ReadScratch::_depth = 0;
+
 /** @param start Start position in session samples.
  *  @param cnt Number of samples to read.
  */
@@ -210,9 +253,16 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 
 	/* Find all the regions that are involved in the bit we are reading,
 	   and sort them by descending layer and ascending position.
+
+	   This is called by the butler for every channel of every track,
+	   use per-thread scratch buffers to avoid allocations.
 	*/
-	std::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt, true);
-	all->sort (ReadSorter ());
+	ReadScratch      scratch;
+	RegionVector&    all (scratch.all ());
+	vector<Segment>& to_do (scratch.to_do ());
+
+	collect_regions_touched_locked (start, start + cnt, true, all);
+	std::sort (all.begin (), all.end (), ReadSorter ());
 
 	/* This will be a list of the bits of our read range that we have
 	   handled completely (ie for which no more regions need to be read).
@@ -220,11 +270,10 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 	*/
 	Temporal::RangeList done;
 
-	/* This will be a list of the bits of regions that we need to read */
-	list<Segment> to_do;
+	/* `to_do' will be a list of the bits of regions that we need to read */
 
 	/* Now go through the `all' list filling in `to_do' and `done' */
-	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
+	for (RegionVector::iterator i = all.begin(); i != all.end(); ++i) {
 		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (*i);
 
 		/* muted regions don't figure into it at all */
@@ -274,7 +323,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 
 	/* Now go backwards through the to_do list doing the actual reads */
 
-	for (list<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
+	for (vector<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
 		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
 		                                                   name(), i->region->name(), i->range.start(),
 		                                                   i->range.length(), (int) chan_n,
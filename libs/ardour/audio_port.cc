@@ -40,6 +40,8 @@ AudioPort::AudioPort (const std::string& name, PortFlags flags)
 	: Port (name, DataType::AUDIO, flags)
 	, _buffer (new AudioBuffer (0))
 	, _data (0)
+	, _shared_input (0)
+	, _src_idle (false)
 {
 	assert (name.find_first_of (':') == string::npos);
 	_src.setup (resampler_quality ());
@@ -71,7 +73,14 @@ AudioPort::cycle_start (pframes_t nframes)
 		/* ardour internal port, just silence input, don't resample */
 		_src.reset ();
 		memset (_data, 0, _cycle_nframes * sizeof (float));
+	} else if (_shared_input) {
+		/* the only connected port was resampled by the PortManager */
+		_src_idle = true;
 	} else {
+		if (_src_idle) {
+			_src.reset ();
+			_src_idle = false;
+		}
 		_src.inp_data  = (float*)port_engine.get_buffer (_port_handle, nframes);
 		_src.inp_count = nframes;
 		_src.out_count = _cycle_nframes;
@@ -90,6 +99,8 @@ void
 AudioPort::cycle_end (pframes_t nframes)
 {
 	Port::cycle_end (nframes);
+	_shared_input = 0;
+
 	if (sends_output() && !_buffer->written() && _port_handle) {
 		if (!_buffer->data (0)) {
 			get_audio_buffer (nframes);
@@ -166,6 +177,9 @@ AudioPort::get_audio_buffer (pframes_t nframes)
 
 	if (!externally_connected () || (0 != (flags() & TransportSyncPort))) {
 		addr = (Sample *) port_engine.get_buffer (_port_handle, nframes);
+	} else if (_shared_input) {
+		/* data was resampled once for all ports connected to the same source */
+		addr = const_cast<Sample*> (&_shared_input[_global_port_buffer_offset]);
 	} else {
 		/* _data was read and resampled as necessary in ::cycle_start */
 		addr = &_data[_global_port_buffer_offset];
@@ -55,6 +55,7 @@
 #include "ardour/search_paths.h"
 #include "ardour/buffer.h"
 #include "ardour/cycle_timer.h"
+#include "ardour/disk_reader.h"
 #include "ardour/internal_send.h"
 #include "ardour/meter.h"
 #include "ardour/midi_port.h"
@@ -271,6 +272,8 @@ AudioEngine::process_callback (pframes_t nframes)
 		return 0;
 	}
 
+	ProcessBenchmark::Cycle bc (_benchmark);
+
 	/* The coreaudio-backend calls thread_init_callback() if
 	 * the hardware changes or pthread_self() changes.
 	 *
@@ -1008,6 +1011,7 @@ AudioEngine::drop_backend ()
 			_session->engine_halted ();
 		}
 		Port::PortDrop (); /* EMIT SIGNAL */
+		drop_input_handles ();
 		TransportMasterManager& tmm (TransportMasterManager::instance());
 		tmm.engine_stopped ();
 		tmm.set_session (0); // unregister TMM ports
@@ -1169,6 +1173,7 @@ AudioEngine::stop (bool for_latency)
 
 	if (stop_engine) {
 		Port::PortDrop ();
+		drop_input_handles ();
 	}
 
 	if (stop_engine) {
@@ -1201,6 +1206,18 @@ AudioEngine::get_dsp_load() const
 	return _backend->dsp_load ();
 }
 
+int
+AudioEngine::start_benchmark (uint32_t n_cycles)
+{
+	if (!_backend || !_running || n_cycles == 0) {
+		return -1;
+	}
+	Glib::Threads::Mutex::Lock lm (_process_lock);
+	_benchmark.start (n_cycles, samples_per_cycle (), sample_rate ());
+	DiskReader::Underrun.connect_same_thread (_benchmark_connection, std::bind (&ProcessBenchmark::underrun, &_benchmark));
+	return 0;
+}
+
 void
 AudioEngine::transport_start ()
 {
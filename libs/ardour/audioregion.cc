@@ -1852,9 +1852,7 @@ AudioRegion::rms (Progress* p) const
 			if (read_raw_internal (buf, fpos, to_read, c) != to_read) {
 				return 0;
 			}
-			for (samplepos_t i = 0; i < to_read; ++i) {
-				rms += buf[i] * buf[i];
-			}
+			rms += sum_of_squares (buf, to_read);
 		}
 		total += to_read;
 		fpos += to_read;
@@ -58,6 +58,8 @@
 #include "pbd/xml++.h"
 
 #include "ardour/audiosource.h"
+#include "ardour/filename_extensions.h"
+#include "ardour/peak_pyramid.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
@@ -81,6 +83,7 @@ AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _peak_byte_max (0)
 	, _peaks_built (false)
+	, _peak_building_cancelled (false)
 	, _peakfile_fd (-1)
 	, peak_leftover_cnt (0)
 	, peak_leftover_size (0)
@@ -97,6 +100,7 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	: Source (s, node)
 	, _peak_byte_max (0)
 	, _peaks_built (false)
+	, _peak_building_cancelled (false)
 	, _peakfile_fd (-1)
 	, peak_leftover_cnt (0)
 	, peak_leftover_size (0)
@@ -209,6 +213,10 @@ AudioSource::touch_peakfile ()
 	tbuf.modtime = time ((time_t*) 0);
 
 	g_utime (_peakpath.c_str(), &tbuf);
+
+	if (g_stat (peak_pyramid_path ().c_str(), &statbuf) == 0) {
+		g_utime (peak_pyramid_path ().c_str(), &tbuf);
+	}
 }
 
 int
@@ -225,11 +233,35 @@ AudioSource::rename_peakfile (string newpath)
 		}
 	}
 
+	string const oldpyramid = peak_pyramid_path ();
+
 	_peakpath = newpath;
 
+	if (Glib::file_test (oldpyramid, Glib::FILE_TEST_EXISTS)) {
+		/* the pyramid is a cache, rebuild it on demand if this fails */
+		if (g_rename (oldpyramid.c_str(), peak_pyramid_path ().c_str()) != 0) {
+			::g_unlink (oldpyramid.c_str());
+		}
+	}
+
 	return 0;
 }
 
+string
+AudioSource::peak_pyramid_path () const
+{
+	return _peakpath + peak_pyramid_suffix;
+}
+
+void
+AudioSource::drop_peak_pyramid ()
+{
+	_peak_pyramid.reset ();
+	if (!_peakpath.empty()) {
+		::g_unlink (peak_pyramid_path ().c_str());
+	}
+}
+
 int
 AudioSource::initialize_peakfile (const string& audio_path, const bool in_session)
 {
@@ -303,6 +335,14 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 
 	if (!empty() && !_peaks_built && _build_missing_peakfiles && _build_peakfiles) {
 		build_peaks_from_scratch ();
+	} else if (_peaks_built && Config->get_use_peak_pyramid () && !PeakPyramid::usable (peak_pyramid_path (), _peakpath, _FPP)) {
+		/* e.g. peakfiles of sessions saved by an older version.
+		 * This runs in a peak-file builder thread, unless peaks
+		 * are set up synchronously.
+		 */
+		if (PeakPyramid::build (peak_pyramid_path (), _peakpath, _FPP)) {
+			::g_unlink (peak_pyramid_path ().c_str());
+		}
 	}
 
 	return 0;
@@ -491,6 +531,18 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		return 0;
 	}
 
+	if (scale < 1.0 && samples_per_file_peak == _FPP && Config->get_use_peak_pyramid ()) {
+
+		/* zoomed out, use reduced peak data if available.
+		 * The pyramid is written along with the peakfile, or
+		 * built when the peakfile is initialized.
+		 */
+		if (0 == PeakPyramid::read_peaks (peak_pyramid_path (), _FPP, peaks, npeaks, start, cnt, samples_per_visual_peak)) {
+			DEBUG_TRACE (DEBUG::Peaks, "PYRAMID PEAKS\n");
+			return 0;
+		}
+	}
+
 	if (scale == 1.0) {
 		off_t first_peak_byte = (start / samples_per_file_peak) * sizeof (PeakData);
 		size_t bytes_to_read = sizeof (PeakData) * read_npeaks;
@@ -832,7 +884,7 @@ AudioSource::build_peaks_from_scratch ()
 
 			lp.release(); // allow butler to refill buffers
 
-			if (_session.deletion_in_progress() || _session.peaks_cleanup_in_progres()) {
+			if (_session.deletion_in_progress() || _session.peaks_cleanup_in_progres() || _peak_building_cancelled.load ()) {
 				cerr << "peak file creation interrupted: " << _name << endmsg;
 				lp.acquire();
 				done_with_peakfile_writes (false);
@@ -877,6 +929,7 @@ AudioSource::close_peakfile ()
 		close (_peakfile_fd);
 		_peakfile_fd = -1;
 	}
+	drop_peak_pyramid ();
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
 	}
@@ -895,6 +948,14 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+
+	if (Config->get_use_peak_pyramid () && !_peak_pyramid) {
+		_peak_pyramid.reset (new PeakPyramid (peak_pyramid_path (), _FPP));
+		if (_peak_pyramid->open ()) {
+			/* not fatal, peaks will be read from the peakfile */
+			drop_peak_pyramid ();
+		}
+	}
 	return 0;
 }
 
@@ -906,6 +967,7 @@ AudioSource::done_with_peakfile_writes (bool done)
 			close (_peakfile_fd);
 			_peakfile_fd = -1;
 		}
+		_peak_pyramid.reset ();
 		return;
 	}
 
@@ -918,6 +980,14 @@ AudioSource::done_with_peakfile_writes (bool done)
 		_peakfile_fd = -1;
 	}
 
+	if (_peak_pyramid) {
+		if (!done || _peak_pyramid->finish (_peakpath)) {
+			drop_peak_pyramid ();
+		} else {
+			_peak_pyramid.reset ();
+		}
+	}
+
 	if (done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
@@ -984,6 +1054,10 @@ AudioSource::compute_and_write_peaks (Sample const * buf, samplecnt_t first_samp
 
 			_peak_byte_max = max (_peak_byte_max, (off_t) (byte + sizeof(PeakData)));
 
+			if (_peak_pyramid && fpp == _FPP && _peak_pyramid->append (&x, 1, peak_leftover_sample / fpp)) {
+				drop_peak_pyramid ();
+			}
+
 			{
 				Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 				PeakRangeReady (peak_leftover_sample, peak_leftover_cnt); /* EMIT SIGNAL */
@@ -1112,6 +1186,10 @@ AudioSource::compute_and_write_peaks (Sample const * buf, samplecnt_t first_samp
 
 	_peak_byte_max = max (_peak_byte_max, (off_t) (first_peak_byte + bytes_to_write));
 
+	if (_peak_pyramid && fpp == _FPP && _peak_pyramid->append (peakbuf.get(), peaks_computed, first_sample / fpp)) {
+		drop_peak_pyramid ();
+	}
+
 	if (samples_done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		PeakRangeReady (first_sample, samples_done); /* EMIT SIGNAL */
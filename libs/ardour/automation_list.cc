@@ -28,9 +28,13 @@
 #include <sstream>
 #include <algorithm>
 
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
 #include "temporal/types_convert.h"
 
 #include "ardour/automation_list.h"
+#include "ardour/automation_sidecar.h"
 #include "ardour/event_type_map.h"
 #include "ardour/parameter_descriptor.h"
 #include "ardour/parameter_types.h"
@@ -64,6 +68,9 @@ static void dumpit (const AutomationList& al, string prefix = "")
 AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::ParameterDescriptor& desc, Temporal::TimeDomainProvider const & tdp)
 	: ControlList(id, desc, tdp)
 	, _before (0)
+	, _events_sidecar_checksum (0)
+	, _events_xml_revision (0)
+	, _events_xml_valid (false)
 {
 	_state = Off;
 	_touching.store (0);
@@ -78,6 +85,9 @@ AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::Param
 AutomationList::AutomationList (const Evoral::Parameter& id, Temporal::TimeDomainProvider const & tdp)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id), tdp)
 	, _before (0)
+	, _events_sidecar_checksum (0)
+	, _events_xml_revision (0)
+	, _events_xml_valid (false)
 {
 	_state = Off;
 	_touching.store (0);
@@ -93,6 +103,9 @@ AutomationList::AutomationList (const AutomationList& other)
 	: ControlList(other)
 	, StatefulDestructible()
 	, _before (0)
+	, _events_sidecar_checksum (0)
+	, _events_xml_revision (0)
+	, _events_xml_valid (false)
 {
 	_state = other._state;
 	_touching.store (other.touching());
@@ -106,6 +119,9 @@ AutomationList::AutomationList (const AutomationList& other)
 AutomationList::AutomationList (const AutomationList& other, timepos_t const & start, timepos_t const & end)
 	: ControlList(other, start, end)
 	, _before (0)
+	, _events_sidecar_checksum (0)
+	, _events_xml_revision (0)
+	, _events_xml_valid (false)
 {
 	_state = other._state;
 	_touching.store (other.touching());
@@ -122,6 +138,9 @@ AutomationList::AutomationList (const AutomationList& other, timepos_t const & s
 AutomationList::AutomationList (const XMLNode& node, Evoral::Parameter id)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id), Temporal::TimeDomainProvider (Temporal::AudioTime)) /* domain may change in ::set_state */
 	, _before (0)
+	, _events_sidecar_checksum (0)
+	, _events_xml_revision (0)
+	, _events_xml_valid (false)
 {
 	_touching.store (0);
 	_interpolation = default_interpolation ();
@@ -368,23 +387,88 @@ XMLNode&
 AutomationList::serialize_events (bool need_lock) const
 {
 	XMLNode* node = new XMLNode (X_("events"));
-	stringstream str;
 
 	Glib::Threads::RWLock::ReaderLock lm (Evoral::ControlList::_lock, Glib::Threads::NOT_LOCK);
 	if (need_lock) {
 		lm.acquire ();
 	}
-	for (const_iterator xx = _events.begin(); xx != _events.end(); ++xx) {
-		str << PBD::to_string ((*xx)->when);
-		str << ' ';
-		str << PBD::to_string ((*xx)->value);
-		str << '\n';
+
+	/* Saving a session serializes all automation, most of which usually
+	 * did not change since the last save. Only re-serialize the events of
+	 * lists that were modified.
+	 */
+	Glib::Threads::Mutex::Lock xl (_events_xml_lock);
+
+	if (!_events_xml_valid || _events_xml_revision != revision ()) {
+		std::string ().swap (_events_xml);
+		_events_sidecar.clear ();
+		_events_xml_revision = revision ();
+		_events_xml_valid    = true;
+	}
+
+	/* Dense automation (e.g. touch-recorded) is stored in a binary
+	 * sidecar file when saving the session, if enabled. Lists that mix
+	 * time-domains are always saved inline.
+	 */
+	std::string const* sidecar_dir = AutomationSidecar::saving ();
+
+	if (sidecar_dir && _events.size () >= AutomationSidecar::min_events) {
+		if (_events_sidecar.empty () || _events_sidecar_dir != *sidecar_dir
+		    || !Glib::file_test (Glib::build_filename (*sidecar_dir, _events_sidecar), Glib::FILE_TEST_EXISTS)) {
+			_events_sidecar.clear ();
+
+			bool const beat_time = _events.front ()->when.is_beats ();
+			bool       ok        = true;
+
+			std::vector<int64_t> when;
+			std::vector<double>  value;
+			when.reserve (_events.size ());
+			value.reserve (_events.size ());
+
+			for (const_iterator xx = _events.begin(); xx != _events.end(); ++xx) {
+				if ((*xx)->when.is_beats () != beat_time) {
+					ok = false;
+					break;
+				}
+				when.push_back ((*xx)->when.val ());
+				value.push_back ((*xx)->value);
+			}
+
+			std::string name;
+			uint64_t    checksum;
+
+			if (ok && 0 == AutomationSidecar::write (*sidecar_dir, id (), beat_time, when, value, name, checksum)) {
+				_events_sidecar          = name;
+				_events_sidecar_dir      = *sidecar_dir;
+				_events_sidecar_checksum = checksum;
+			}
+		}
+
+		if (!_events_sidecar.empty ()) {
+			/* do not also keep the events as text */
+			std::string ().swap (_events_xml);
+			node->set_property (X_("sidecar"), _events_sidecar);
+			node->set_property (X_("count"), (uint64_t) _events.size ());
+			node->set_property (X_("checksum"), _events_sidecar_checksum);
+			return *node;
+		}
+	}
+
+	if (_events_xml.empty ()) {
+		stringstream str;
+		for (const_iterator xx = _events.begin(); xx != _events.end(); ++xx) {
+			str << PBD::to_string ((*xx)->when);
+			str << ' ';
+			str << PBD::to_string ((*xx)->value);
+			str << '\n';
+		}
+		_events_xml = str.str ();
 	}
 
 	/* XML is a bit weird */
 
 	XMLNode* content_node = new XMLNode (X_("foo")); /* it gets renamed by libxml when we set content */
-	content_node->set_content (str.str());
+	content_node->set_content (_events_xml);
 
 	node->add_child_nocopy (*content_node);
 
@@ -394,6 +478,11 @@ AutomationList::serialize_events (bool need_lock) const
 int
 AutomationList::deserialize_events (const XMLNode& node)
 {
+	std::string sidecar;
+	if (node.get_property (X_("sidecar"), sidecar)) {
+		return deserialize_sidecar (node, sidecar);
+	}
+
 	if (node.children().empty()) {
 		return -1;
 	}
@@ -442,6 +531,40 @@ AutomationList::deserialize_events (const XMLNode& node)
 	return 0;
 }
 
+int
+AutomationList::deserialize_sidecar (const XMLNode& node, std::string const& name)
+{
+	uint64_t checksum;
+	if (!node.get_property (X_("checksum"), checksum)) {
+		return -1;
+	}
+
+	bool                 beat_time;
+	std::vector<int64_t> when;
+	std::vector<double>  value;
+
+	if (AutomationSidecar::read (AutomationSidecar::directory (), name, checksum, beat_time, when, value)) {
+		error << string_compose (_("automation list: cannot load events from \"%1\", all points ignored"), name) << endmsg;
+		return -1;
+	}
+
+	ControlList::freeze ();
+	clear ();
+
+	for (size_t i = 0; i < when.size (); ++i) {
+		timepos_t const x = beat_time ? timepos_t::from_ticks (when[i]) : timepos_t::from_superclock (when[i]);
+		double const    y = std::min ((double)_desc.upper, std::max ((double)_desc.lower, value[i]));
+		fast_simple_add (x, y);
+	}
+
+	mark_dirty ();
+	maybe_signal_changed ();
+
+	thaw ();
+
+	return 0;
+}
+
 int
 AutomationList::set_state (const XMLNode& node, int version)
 {
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef COMPILER_MSVC
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/scoped_file_descriptor.h"
+#include "pbd/string_convert.h"
+#include "pbd/xml++.h"
+
+#include "temporal/timeline.h"
+#include "temporal/types_convert.h"
+
+#include "ardour/automation_sidecar.h"
+
+#include "pbd/i18n.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char sidecar_magic[8] = { 'A', 'R', 'D', 'A', 'U', 'T', 'O', 'L' };
+
+std::string                     AutomationSidecar::_directory;
+thread_local std::string const* AutomationSidecar::_saving = 0;
+
+AutomationSidecar::Saving::Saving (bool yn, std::string const& dir)
+	: _old (_saving)
+{
+	if (yn) {
+		_saving = &dir;
+	}
+}
+
+AutomationSidecar::Saving::~Saving ()
+{
+	_saving = _old;
+}
+
+void
+AutomationSidecar::set_directory (std::string const& dir)
+{
+	_directory = dir;
+}
+
+uint64_t
+AutomationSidecar::compute_checksum (bool beat_time, int64_t const* when, double const* value, size_t n)
+{
+	/* FNV-1a, 64 bit */
+	uint64_t h = 0xcbf29ce484222325ULL;
+
+	auto mix = [&h] (void const* data, size_t len) {
+		uint8_t const* p = (uint8_t const*) data;
+		for (size_t i = 0; i < len; ++i) {
+			h ^= p[i];
+			h *= 0x100000001b3ULL;
+		}
+	};
+
+	uint32_t const bt = beat_time ? 1 : 0;
+	mix (&bt, sizeof (bt));
+	mix (when, n * sizeof (int64_t));
+	mix (value, n * sizeof (double));
+	return h;
+}
+
+int
+AutomationSidecar::write (std::string const& dir, PBD::ID const& id, bool beat_time,
+                          std::vector<int64_t> const& when, std::vector<double> const& value,
+                          std::string& name, uint64_t& checksum)
+{
+	if (when.size () != value.size ()) {
+		return -1;
+	}
+
+	size_t const n = when.size ();
+	checksum       = compute_checksum (beat_time, when.data (), value.data (), n);
+
+	char buf[32];
+	snprintf (buf, sizeof (buf), "%016" PRIx64, checksum);
+	name = string_compose ("%1-%2.alist", id.to_s (), buf);
+
+	std::string const path = Glib::build_filename (dir, name);
+
+	if (Glib::file_test (path, Glib::FILE_TEST_EXISTS)) {
+		/* content addressed, an existing file is identical */
+		return 0;
+	}
+
+	if (g_mkdir_with_parents (dir.c_str (), 0755)) {
+		error << string_compose (_("AutomationSidecar: cannot create directory \"%1\" (%2)"), dir, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	Header h;
+	memset (&h, 0, sizeof (Header));
+	memcpy (h.magic, sidecar_magic, sizeof (h.magic));
+	h.version   = version;
+	h.beat_time = beat_time ? 1 : 0;
+	h.n_events  = n;
+	h.checksum  = checksum;
+
+	std::string const tmp = path + ".tmp";
+
+	{
+		ScopedFileDescriptor sfd (g_open (tmp.c_str (), O_CREAT | O_TRUNC | O_RDWR, 0644));
+		if (sfd < 0) {
+			error << string_compose (_("AutomationSidecar: cannot open \"%1\" (%2)"), tmp, strerror (errno)) << endmsg;
+			return -1;
+		}
+
+		if (::write (sfd, &h, sizeof (Header)) != (ssize_t) sizeof (Header)
+		    || ::write (sfd, when.data (), n * sizeof (int64_t)) != (ssize_t) (n * sizeof (int64_t))
+		    || ::write (sfd, value.data (), n * sizeof (double)) != (ssize_t) (n * sizeof (double))) {
+			error << string_compose (_("AutomationSidecar: could not write \"%1\" (%2)"), tmp, strerror (errno)) << endmsg;
+			::g_unlink (tmp.c_str ());
+			return -1;
+		}
+	}
+
+	if (::g_rename (tmp.c_str (), path.c_str ())) {
+		error << string_compose (_("AutomationSidecar: could not rename \"%1\" (%2)"), tmp, strerror (errno)) << endmsg;
+		::g_unlink (tmp.c_str ());
+		return -1;
+	}
+
+	return 0;
+}
+
+int
+AutomationSidecar::read (std::string const& dir, std::string const& name, uint64_t checksum, bool& beat_time,
+                         std::vector<int64_t>& when, std::vector<double>& value)
+{
+	if (dir.empty () || name.empty () || name.find (G_DIR_SEPARATOR) != std::string::npos) {
+		return -1;
+	}
+
+	std::string const path = Glib::build_filename (dir, name);
+
+	GStatBuf statbuf;
+	if (g_stat (path.c_str (), &statbuf) || statbuf.st_size < (off_t) sizeof (Header)) {
+		error << string_compose (_("AutomationSidecar: missing or truncated file \"%1\""), path) << endmsg;
+		return -1;
+	}
+
+	ScopedFileDescriptor sfd (g_open (path.c_str (), O_RDONLY, 0444));
+	if (sfd < 0) {
+		error << string_compose (_("AutomationSidecar: cannot open \"%1\" (%2)"), path, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	size_t const map_length = statbuf.st_size;
+
+#ifdef PLATFORM_WINDOWS
+	std::vector<char> data (map_length);
+	if (::read (sfd, data.data (), map_length) != (ssize_t) map_length) {
+		error << string_compose (_("AutomationSidecar: could not read \"%1\""), path) << endmsg;
+		return -1;
+	}
+	char const* addr = data.data ();
+#else
+	char* addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, 0);
+	if (addr == MAP_FAILED) {
+		error << string_compose (_("map failed - could not mmap automation data %1."), path) << endmsg;
+		return -1;
+	}
+#endif
+
+	int rv = -1;
+
+	Header h;
+	memcpy (&h, addr, sizeof (Header));
+
+	/* n_events is not trusted, the size check must not overflow */
+	if (memcmp (h.magic, sidecar_magic, sizeof (h.magic)) || h.version != version) {
+		error << string_compose (_("AutomationSidecar: \"%1\" is not a supported automation file"), path) << endmsg;
+	} else if (h.checksum != checksum || map_length < sizeof (Header) || h.n_events > (map_length - sizeof (Header)) / (sizeof (int64_t) + sizeof (double))) {
+		error << string_compose (_("AutomationSidecar: \"%1\" does not match the session"), path) << endmsg;
+	} else {
+		size_t const n = h.n_events;
+		when.resize (n);
+		value.resize (n);
+		memcpy (when.data (), addr + sizeof (Header), n * sizeof (int64_t));
+		memcpy (value.data (), addr + sizeof (Header) + n * sizeof (int64_t), n * sizeof (double));
+		beat_time = h.beat_time != 0;
+
+		if (compute_checksum (beat_time, when.data (), value.data (), n) == checksum) {
+			rv = 0;
+		} else {
+			error << string_compose (_("AutomationSidecar: checksum mismatch in \"%1\""), path) << endmsg;
+		}
+	}
+
+#ifndef PLATFORM_WINDOWS
+	munmap (addr, map_length);
+#endif
+
+	return rv;
+}
+
+void
+AutomationSidecar::inline_events (XMLNode& node, std::string const& dir)
+{
+	std::string name;
+	uint64_t    checksum;
+
+	if (node.name () == X_("events") && node.get_property (X_("sidecar"), name) && node.get_property (X_("checksum"), checksum)) {
+		bool                 beat_time;
+		std::vector<int64_t> when;
+		std::vector<double>  value;
+
+		if (read (dir, name, checksum, beat_time, when, value)) {
+			/* leave the reference, loading the list reports the error */
+			return;
+		}
+
+		std::stringstream str;
+		for (size_t i = 0; i < when.size (); ++i) {
+			str << PBD::to_string (beat_time ? Temporal::timepos_t::from_ticks (when[i]) : Temporal::timepos_t::from_superclock (when[i]));
+			str << ' ';
+			str << PBD::to_string (value[i]);
+			str << '\n';
+		}
+
+		node.remove_property (X_("sidecar"));
+		node.remove_property (X_("count"));
+		node.remove_property (X_("checksum"));
+
+		XMLNode* content_node = new XMLNode (X_("foo")); /* it gets renamed by libxml when we set content */
+		content_node->set_content (str.str ());
+		node.add_child_nocopy (*content_node);
+		return;
+	}
+
+	for (auto const& child : node.children ()) {
+		inline_events (*child, dir);
+	}
+}
@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -45,8 +46,10 @@
 #include "ardour/disk_reader.h"
 #include "ardour/io.h"
 #include "ardour/io_tasklist.h"
+#include "ardour/location.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
+#include "ardour/triggerbox.h"
 
 #include "pbd/i18n.h"
 
@@ -62,6 +65,7 @@ Butler::Butler (Session& s)
 	, _audio_capture_buffer_size (0)
 	, _audio_playback_buffer_size (0)
 	, _midi_buffer_size (0)
+	, _locate_prefetch_active (false)
 	, pool_trash (16)
 	, _xthread (true)
 {
@@ -313,6 +317,9 @@ Butler::thread_work ()
 		tl->process ();
 		tl.reset ();
 
+		/* clips that are too large to be kept in memory */
+		AudioClipStream::refill_all ();
+
 		if (i != rl_with_auditioner.begin () && i != rl_with_auditioner.end ()) {
 			/* we didn't get to all the streams */
 			disk_work_outstanding = true;
@@ -338,8 +345,15 @@ Butler::thread_work ()
 			goto restart;
 		}
 
+		if (!err && !disk_work_outstanding && should_run && !transport_work_requested ()) {
+			/* nothing else to do, use the time to read data at
+			 * likely locate targets */
+			disk_work_outstanding = prefetch_locate_targets (rl);
+		}
+
 		if (!disk_work_outstanding) {
 			_session.refresh_disk_space ();
+			_session.refresh_process_graph_priorities ();
 		}
 
 		{
@@ -409,6 +423,105 @@ Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32
 	return disk_work_outstanding;
 }
 
+void
+Butler::note_locate (samplepos_t pos)
+{
+	Glib::Threads::Mutex::Lock lm (_recent_locates_lock);
+	std::vector<samplepos_t>::iterator i = std::find (_recent_locates.begin (), _recent_locates.end (), pos);
+	if (i != _recent_locates.end ()) {
+		_recent_locates.erase (i);
+	} else if (_recent_locates.size () >= 4) {
+		_recent_locates.pop_back ();
+	}
+	_recent_locates.insert (_recent_locates.begin (), pos);
+}
+
+bool
+Butler::prefetch_locate_targets (std::shared_ptr<RouteList const> rl)
+{
+	/* called when the butler has no other disk work.
+	 * Collect likely locate targets in order of priority, and let each
+	 * track read (at most) one of them. Returns true if more work
+	 * may remain.
+	 */
+	_prefetch_targets.clear ();
+
+	if (Config->get_locate_prefetch_megabytes () > 0 && !_session.actively_recording () && !_session.exporting () && !_session.loading ()) {
+		std::vector<samplepos_t>& t (_prefetch_targets);
+
+		{
+			Glib::Threads::Mutex::Lock lm (_recent_locates_lock);
+			t = _recent_locates;
+		}
+
+		Locations* loc = _session.locations ();
+		if (Location* l = loc->auto_loop_location ()) {
+			t.push_back (l->start_sample ());
+		}
+		if (Location* l = loc->auto_punch_location ()) {
+			t.push_back (l->start_sample ());
+		}
+		if (Location* l = loc->session_range_location ()) {
+			t.push_back (l->start_sample ());
+		}
+
+		/* markers, closest to the playhead first */
+		Locations::LocationList ll;
+		loc->find_all_between (timepos_t (0), timepos_t::max (Temporal::AudioTime), ll, Location::IsMark);
+
+		samplepos_t const            now = _session.transport_sample ();
+		std::vector<samplepos_t> marks;
+		for (auto const& l : ll) {
+			if (!l->is_hidden () && !l->is_xrun () && !l->is_cue_marker ()) {
+				marks.push_back (l->start_sample ());
+			}
+		}
+		std::sort (marks.begin (), marks.end (), [now] (samplepos_t a, samplepos_t b) {
+			return ::llabs (a - now) < ::llabs (b - now);
+		});
+		t.insert (t.end (), marks.begin (), marks.end ());
+
+		/* remove duplicates, retaining order */
+		std::vector<samplepos_t>::iterator e = t.begin ();
+		for (std::vector<samplepos_t>::iterator i = t.begin (); i != t.end (); ++i) {
+			if (std::find (t.begin (), e, *i) == e) {
+				*e++ = *i;
+			}
+		}
+		t.erase (e, t.end ());
+
+		if (t.size () > 16) {
+			t.resize (16);
+		}
+	}
+
+	if (_prefetch_targets.empty () && !_locate_prefetch_active) {
+		return false;
+	}
+
+	/* with an empty target list, tracks drop their cached data */
+	_locate_prefetch_active = !_prefetch_targets.empty ();
+
+	std::atomic<bool>           more (false);
+	std::shared_ptr<IOTaskList> tl = _session.io_tasklist ();
+
+	for (auto const& r : *rl) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+		if (!tr || transport_work_requested ()) {
+			continue;
+		}
+		tl->push_back ([this, tr, &more]() {
+			if (tr->prefetch_locate_targets (_prefetch_targets) > 0) {
+				more.store (true);
+			}
+		});
+	}
+
+	tl->process ();
+
+	return more.load ();
+}
+
 void
 Butler::schedule_transport_work ()
 {
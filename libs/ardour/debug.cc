@@ -92,6 +92,7 @@ PBD::DebugBits PBD::DEBUG::Push2 = PBD::new_debug_bit ("push2");
 PBD::DebugBits PBD::DEBUG::RegionFx = PBD::new_debug_bit ("regionfx");
 PBD::DebugBits PBD::DEBUG::Selection = PBD::new_debug_bit ("selection");
 PBD::DebugBits PBD::DEBUG::SessionEvents = PBD::new_debug_bit ("sessionevents");
+PBD::DebugBits PBD::DEBUG::SessionLoad = PBD::new_debug_bit ("sessionload");
 PBD::DebugBits PBD::DEBUG::Slave = PBD::new_debug_bit ("slave");
 PBD::DebugBits PBD::DEBUG::Solo = PBD::new_debug_bit ("solo");
 PBD::DebugBits PBD::DEBUG::SaveState = PBD::new_debug_bit ("savestate");
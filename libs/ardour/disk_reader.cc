@@ -17,6 +17,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "pbd/enumwriter.h"
 #include "pbd/memento_command.h"
 #include "pbd/playback_buffer.h"
@@ -54,6 +56,7 @@ std::atomic<int>      DiskReader::_no_disk_output (0);
 DiskReader::Declicker DiskReader::loop_declick_in;
 DiskReader::Declicker DiskReader::loop_declick_out;
 samplecnt_t           DiskReader::loop_fade_length (0);
+std::atomic<int64_t>  DiskReader::_locate_cache_bytes (0);
 
 DiskReader::DiskReader (Session& s, Track& t, string const& str, Temporal::TimeDomainProvider const & tdp, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("player:") + str, f, tdp)
@@ -69,11 +72,15 @@ DiskReader::DiskReader (Session& s, Track& t, string const& str, Temporal::TimeD
 	file_sample[DataType::AUDIO] = 0;
 	file_sample[DataType::MIDI]  = 0;
 	_pending_overwrite.store (OverwriteReason (0));
+	_locate_cache_dirty.store (false);
 }
 
 DiskReader::~DiskReader ()
 {
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("DiskReader %1 @ %2 deleted\n", _name, this));
+
+	Glib::Threads::Mutex::Lock lm (_locate_cache_lock);
+	drop_locate_cache ();
 }
 
 std::string
@@ -240,11 +247,14 @@ DiskReader::adjust_buffering ()
 	for (auto const& chan : *c) {
 		chan->resize (bufsz);
 	}
+
+	_locate_cache_dirty.store (true);
 }
 
 void
 DiskReader::playlist_modified ()
 {
+	_locate_cache_dirty.store (true);
 	_session.request_overwrite_buffer (_track.shared_ptr (), PlaylistModified);
 }
 
@@ -261,6 +271,8 @@ DiskReader::use_playlist (DataType dt, std::shared_ptr<Playlist> playlist)
 		return -1;
 	}
 
+	_locate_cache_dirty.store (true);
+
 	/* don't do this if we've already asked for it *or* if we are setting up
 	 * the diskstream for the very first time - the input changed handling will
 	 * take care of the buffer refill. */
@@ -388,6 +400,20 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 		const float          initial_declick_gain = _declick_amp.gain ();
 		const sampleoffset_t declick_offs         = _declick_offs;
 
+		/* The declick gain-curve is identical for all channels. Compute it
+		 * once (this also advances _declick_amp), fold in the scaling, and
+		 * apply it to each channel using a vector multiply.
+		 */
+		gain_t* declick_curve = 0;
+
+		if (initial_declick_gain != target_gain) {
+			declick_curve = _session.scratch_automation_buffer ();
+			_declick_amp.compute_gain_curve (declick_curve, nframes, target_gain);
+			if (scaling != 1.0) {
+				apply_gain_to_buffer (declick_curve, nframes, scaling);
+			}
+		}
+
 		for (n = 0, chan = c->begin (); chan != c->end (); ++chan, ++n) {
 			ReaderChannelInfo* chaninfo = dynamic_cast<ReaderChannelInfo*> (*chan);
 			AudioBuffer&       output (bufs.get_audio (n % n_buffers));
@@ -411,9 +437,6 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 				}
 			}
 
-			/* reset _declick_amp to the correct gain before processing this channel. */
-			_declick_amp.set_gain (initial_declick_gain);
-
 			if (!declick_out) {
 				const samplecnt_t available = chaninfo->rbuf->read (disk_buf.data (), disk_samples_to_consume);
 
@@ -432,7 +455,7 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 					return;
 				}
 
-			} else if (_declick_amp.gain () != target_gain) {
+			} else if (declick_curve) {
 				assert (target_gain == 0);
 
 				/* note that this is a non-committing read: it
@@ -451,11 +474,11 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 				}
 			}
 
-			_declick_amp.apply_gain (disk_buf, nframes, target_gain);
-
-			/* _declick_amp is now left with the correct gain after processing nframes */
-
-			Amp::apply_simple_gain (disk_buf, nframes, scaling);
+			if (declick_curve) {
+				apply_gain_vector_to_buffer (disk_buf.data (), declick_curve, nframes);
+			} else {
+				Amp::apply_simple_gain (disk_buf, nframes, target_gain * scaling);
+			}
 
 			if (ms & MonitoringInput) {
 				/* mix the disk signal into the input signal (already in bufs) */
@@ -908,7 +931,10 @@ DiskReader::seek (samplepos_t sample, bool complete_refill)
 	file_sample[DataType::AUDIO] = sample;
 	file_sample[DataType::MIDI]  = sample;
 
-	if (complete_refill) {
+	if (!read_reversed && !read_loop && read_locate_cache (sample, ::llabs (shift), *c)) {
+		/* the start was prefetched, the butler reads the rest */
+		ret = 0;
+	} else if (complete_refill) {
 		/* call _do_refill() to refill the entire buffer, using
 		 * the largest reads possible. */
 		while ((ret = do_refill_with_alloc (false, read_reversed)) > 0)
@@ -941,6 +967,138 @@ DiskReader::seek (samplepos_t sample, bool complete_refill)
 	return ret;
 }
 
+bool
+DiskReader::read_locate_cache (samplepos_t start, samplecnt_t min_length, ChannelList const& c)
+{
+	/* called from seek() after the buffers have been reset */
+
+	Glib::Threads::Mutex::Lock lm (_locate_cache_lock);
+
+	if (_locate_cache_dirty.exchange (false)) {
+		drop_locate_cache ();
+		return false;
+	}
+
+	for (auto const& e : _locate_cache) {
+		if (e.start != start || e.data.size () != c.size ()) {
+			continue;
+		}
+
+		samplecnt_t const n = std::min<samplecnt_t> (e.length, c.front ()->rbuf->write_space ());
+
+		if (n <= min_length) {
+			return false;
+		}
+
+		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("'%1': seek to %2 using %3 prefetched samples\n", owner ()->name (), start, n));
+
+		uint32_t chn = 0;
+		for (auto const& chan : c) {
+			chan->rbuf->write (e.data[chn++].get (), n);
+			dynamic_cast<ReaderChannelInfo*> (chan)->initialized = true;
+		}
+
+		file_sample[DataType::AUDIO] = start + n;
+		_last_read_reversed          = false;
+		_last_read_loop              = false;
+		return true;
+	}
+
+	return false;
+}
+
+void
+DiskReader::drop_locate_cache ()
+{
+	/* _locate_cache_lock is held */
+	for (auto const& e : _locate_cache) {
+		_locate_cache_bytes.fetch_sub (e.length * e.data.size () * sizeof (Sample));
+	}
+	_locate_cache.clear ();
+}
+
+int
+DiskReader::prefetch_locate_targets (std::vector<samplepos_t> const& targets)
+{
+	std::shared_ptr<ChannelList const> c = channels.reader ();
+
+	Glib::Threads::Mutex::Lock lm (_locate_cache_lock);
+
+	if (_locate_cache_dirty.exchange (false)) {
+		drop_locate_cache ();
+	}
+
+	if (targets.empty () || c->empty () || !_playlists[DataType::AUDIO] || _loop_location) {
+		/* seek() does not use prefetched data when looping, since
+		 * loop-fades modify the data that is read. */
+		drop_locate_cache ();
+		return 0;
+	}
+
+	/* prefetched data starts where seek() will start reading */
+	samplecnt_t const rsize = c->front ()->rbuf->reservation_size ();
+	samplecnt_t const len   = std::min<samplecnt_t> (2 * _chunk_samples, c->front ()->rbuf->bufsize () / 2);
+	int64_t const     bytes = len * c->size () * sizeof (Sample);
+	int64_t const     limit = (int64_t)Config->get_locate_prefetch_megabytes () * 1048576;
+
+	std::vector<samplepos_t> starts;
+	for (auto const& t : targets) {
+		starts.push_back (t - std::min (rsize, t));
+	}
+
+	/* drop data that is no longer of interest */
+	for (auto i = _locate_cache.begin (); i != _locate_cache.end ();) {
+		if (i->length != len || i->data.size () != c->size () || std::find (starts.begin (), starts.end (), i->start) == starts.end ()) {
+			_locate_cache_bytes.fetch_sub (i->length * i->data.size () * sizeof (Sample));
+			i = _locate_cache.erase (i);
+		} else {
+			++i;
+		}
+	}
+
+	for (auto const& start : starts) {
+		if (std::find_if (_locate_cache.begin (), _locate_cache.end (), [start] (LocateCacheEntry const& e) { return e.start == start; }) != _locate_cache.end ()) {
+			continue;
+		}
+
+		if (_locate_cache_bytes.fetch_add (bytes) + bytes > limit) {
+			_locate_cache_bytes.fetch_sub (bytes);
+			return 0;
+		}
+
+		/* audio_read() updates those, but this is not a read into the playback buffer */
+		std::optional<bool> const last_read_reversed = _last_read_reversed;
+		std::optional<bool> const last_read_loop     = _last_read_loop;
+
+		LocateCacheEntry e;
+		e.start  = start;
+		e.length = len;
+
+		uint32_t chn = 0;
+		for (auto const& chan : *c) {
+			std::unique_ptr<Sample[]> buf (new Sample[len]);
+			samplepos_t               pos = start;
+			if (audio_read (buf.get (), _mixdown_buffer, _gain_buffer, pos, len, dynamic_cast<ReaderChannelInfo*> (chan), chn++, false) != len) {
+				break;
+			}
+			e.data.push_back (std::move (buf));
+		}
+
+		_last_read_reversed = last_read_reversed;
+		_last_read_loop     = last_read_loop;
+
+		if (e.data.size () != c->size () || _loop_location) {
+			_locate_cache_bytes.fetch_sub (bytes);
+			return 0;
+		}
+
+		_locate_cache.push_back (std::move (e));
+		return 1;
+	}
+
+	return 0;
+}
+
 bool
 DiskReader::can_internal_playback_seek (sampleoffset_t distance)
 {
@@ -1300,6 +1458,18 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 
 	samplepos_t file_sample_tmp = fsa;
 
+	/* If there are no regions in the range to be read, write silence
+	 * directly instead of having the playlist produce it for every channel.
+	 */
+	bool silent = false;
+
+	if (!reversed && !_loop_location && _playlists[DataType::AUDIO]) {
+		samplecnt_t const n = min (total_space, samples_to_read);
+		audio_playlist ()->collect_regions_touched (timepos_t (fsa), timepos_t (fsa + n), _refill_regions, true);
+		silent = _refill_regions.empty ();
+		_refill_regions.clear ();
+	}
+
 #if 0
 	int64_t before = g_get_monotonic_time ();
 	int64_t elapsed;
@@ -1328,6 +1498,10 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 			if (!_playlists[DataType::AUDIO]) {
 				chan->rbuf->write_zero (to_read);
 
+			} else if (silent) {
+				chan->rbuf->write_zero (to_read);
+				file_sample_tmp += to_read;
+
 			} else {
 				samplecnt_t nread, nwritten;
 				if ((nread = audio_read (sum_buffer, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, rci, chan_n, reversed)) != to_read) {
@@ -1635,31 +1809,32 @@ DiskReader::DeclickAmp::DeclickAmp (samplecnt_t sample_rate)
 	_g = 0;
 }
 
+/** Fill @a curve with @a n_samples gain coefficients fading from the
+ * current gain towards @a target, and advance the current gain.
+ */
 void
-DiskReader::DeclickAmp::apply_gain (AudioBuffer& buf, samplecnt_t n_samples, const float target, sampleoffset_t buffer_offset)
+DiskReader::DeclickAmp::compute_gain_curve (gain_t* curve, samplecnt_t n_samples, const float target)
 {
-	if (n_samples == 0) {
-		return;
-	}
 	float g = _g;
 
 	if (g == target) {
-		assert (buffer_offset == 0);
-		Amp::apply_simple_gain (buf, n_samples, target, 0);
+		for (samplecnt_t i = 0; i < n_samples; ++i) {
+			curve[i] = target;
+		}
 		return;
 	}
 
-	const float   a      = _a;
-	Sample* const buffer = buf.data ();
+	const float a = _a;
 
 	const int max_nproc = 4;
 	uint32_t  remain    = n_samples;
-	uint32_t  offset    = buffer_offset;
+	uint32_t  offset    = 0;
 
+	/* max_nproc samples share the same gain coefficient */
 	while (remain > 0) {
 		uint32_t n_proc = remain > max_nproc ? max_nproc : remain;
 		for (uint32_t i = 0; i < n_proc; ++i) {
-			buffer[offset + i] *= g;
+			curve[offset + i] = g;
 		}
 #if 1
 		g += a * (target - g);
@@ -46,6 +46,7 @@ using namespace std;
 
 ARDOUR::samplecnt_t DiskWriter::_chunk_samples = DiskWriter::default_chunk_samples ();
 PBD::Signal<void()> DiskWriter::Overrun;
+std::atomic<float> DiskWriter::_capture_margin (1.f);
 
 DiskWriter::DiskWriter (Session& s, Track& t, string const & str, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("recorder:") + str, f, Temporal::TimeDomainProvider (Config->get_default_automation_time_domain()))
@@ -626,6 +627,12 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 				memcpy (chaninfo->rw_vector.buf[1], incoming + first, sizeof (Sample) * (rec_nframes - first));
 			}
 
+			if (n == 1) {
+				const float margin = (float) (chaninfo->rw_vector.len[0] + chaninfo->rw_vector.len[1] - rec_nframes) / chaninfo->wbuf->bufsize ();
+				float cur = _capture_margin.load ();
+				while (margin < cur && !_capture_margin.compare_exchange_weak (cur, margin)) ;
+			}
+
 			chaninfo->wbuf->increment_write_ptr (rec_nframes);
 
 		}
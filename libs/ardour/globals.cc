@@ -158,6 +158,12 @@ mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
 
+apply_gain_vector_to_buffer_t  ARDOUR::apply_gain_vector_to_buffer  = 0;
+mix_buffers_with_gain_vector_t ARDOUR::mix_buffers_with_gain_vector = 0;
+sum_of_squares_t               ARDOUR::sum_of_squares               = 0;
+interleave_channel_t           ARDOUR::interleave_channel           = 0;
+deinterleave_channel_t         ARDOUR::deinterleave_channel         = 0;
+
 PBD::Signal<void(std::string)>                    ARDOUR::BootMessage;
 PBD::Signal<void(std::string, std::string, bool)> ARDOUR::PluginScanMessage;
 PBD::Signal<void(int)>                            ARDOUR::PluginScanTimeout;
@@ -212,6 +218,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
 
+			apply_gain_vector_to_buffer  = x86_avx512f_apply_gain_vector_to_buffer;
+			mix_buffers_with_gain_vector = x86_avx512f_mix_buffers_with_gain_vector;
+			sum_of_squares               = x86_avx512f_sum_of_squares;
+			interleave_channel           = x86_sse_interleave_channel;
+			deinterleave_channel         = x86_sse_deinterleave_channel;
+
 			generic_mix_functions = false;
 
 		} else
@@ -229,6 +241,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			apply_gain_vector_to_buffer  = x86_sse_avx_apply_gain_vector_to_buffer;
+			mix_buffers_with_gain_vector = x86_sse_avx_mix_buffers_with_gain_vector;
+			sum_of_squares               = x86_sse_avx_sum_of_squares;
+			interleave_channel           = x86_sse_interleave_channel;
+			deinterleave_channel         = x86_sse_deinterleave_channel;
+
 			generic_mix_functions = false;
 
 		} else
@@ -244,6 +262,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
 
+			apply_gain_vector_to_buffer  = x86_sse_avx_apply_gain_vector_to_buffer;
+			mix_buffers_with_gain_vector = x86_sse_avx_mix_buffers_with_gain_vector;
+			sum_of_squares               = x86_sse_avx_sum_of_squares;
+			interleave_channel           = x86_sse_interleave_channel;
+			deinterleave_channel         = x86_sse_deinterleave_channel;
+
 			generic_mix_functions = false;
 
 		} else if (fpu->has_sse ()) {
@@ -257,6 +281,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
 
+			apply_gain_vector_to_buffer  = x86_sse_apply_gain_vector_to_buffer;
+			mix_buffers_with_gain_vector = x86_sse_mix_buffers_with_gain_vector;
+			sum_of_squares               = x86_sse_sum_of_squares;
+			interleave_channel           = x86_sse_interleave_channel;
+			deinterleave_channel         = x86_sse_deinterleave_channel;
+
 			generic_mix_functions = false;
 		}
 
@@ -272,6 +302,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
 
+			apply_gain_vector_to_buffer  = arm_neon_apply_gain_vector_to_buffer;
+			mix_buffers_with_gain_vector = arm_neon_mix_buffers_with_gain_vector;
+			sum_of_squares               = arm_neon_sum_of_squares;
+			interleave_channel           = arm_neon_interleave_channel;
+			deinterleave_channel         = arm_neon_deinterleave_channel;
+
 			generic_mix_functions = false;
 		}
 
@@ -285,6 +321,12 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
 
+			apply_gain_vector_to_buffer  = veclib_apply_gain_vector_to_buffer;
+			mix_buffers_with_gain_vector = veclib_mix_buffers_with_gain_vector;
+			sum_of_squares               = veclib_sum_of_squares;
+			interleave_channel           = default_interleave_channel;
+			deinterleave_channel         = default_deinterleave_channel;
+
 			generic_mix_functions = false;
 
 			info << "Apple VecLib H/W specific optimizations in use" << endmsg;
@@ -304,6 +346,12 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
 
+		apply_gain_vector_to_buffer  = default_apply_gain_vector_to_buffer;
+		mix_buffers_with_gain_vector = default_mix_buffers_with_gain_vector;
+		sum_of_squares               = default_sum_of_squares;
+		interleave_channel           = default_interleave_channel;
+		deinterleave_channel         = default_deinterleave_channel;
+
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
 
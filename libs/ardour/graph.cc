@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <stdio.h>
 
@@ -35,6 +36,7 @@
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -47,6 +49,9 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+/* index of the calling process-thread in Graph::_thread_deques[], -1 for non-graph threads */
+static thread_local int graph_thread_slot = -1;
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -65,9 +70,14 @@ Graph::Graph (Session& session)
 	, _execution_sem ("graph_execution", 0)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
+	, _work_stealing (false)
+	, _cycle_cnt (0)
+	, _cycle_cnt_start (-1)
 	, _graph_empty (true)
 	, _graph_chain (0)
 {
+	_timing_enabled.store (0);
+	_timing_dropped.store (0);
 	_terminal_refcnt.store (0);
 	_terminate.store (0);
 	_n_workers.store (0);
@@ -76,6 +86,9 @@ Graph::Graph (Session& session)
 
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
+	for (auto& q : _priority_queue) {
+		q.reserve (1024);
+	}
 
 	ARDOUR::AudioEngine::instance ()->Running.connect_same_thread (engine_connections, std::bind (&Graph::reset_thread_list, this));
 	ARDOUR::AudioEngine::instance ()->Stopped.connect_same_thread (engine_connections, std::bind (&Graph::engine_stopped, this));
@@ -121,6 +134,8 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	setup_thread_deques (num_threads);
+
 	/* Allow threads to run */
 	_terminate.store (0);
 
@@ -153,7 +168,41 @@ Graph::session_going_away ()
 	/* now drop all references on the nodes. */
 	_trigger_queue_size.store (0);
 	_trigger_queue.clear ();
+	for (auto& q : _priority_queue) {
+		q.clear ();
+	}
+	drop_thread_deques ();
 	_graph_chain = 0;
+
+	Glib::Threads::Mutex::Lock lx (_timing_lock);
+	_timing_enabled.store (0);
+	for (auto& rb : _timing_rb) {
+		delete rb;
+	}
+	_timing_rb.clear ();
+}
+
+void
+Graph::setup_thread_deques (uint32_t n_threads)
+{
+	drop_thread_deques ();
+	for (auto& q : _thread_deques) {
+		for (uint32_t i = 0; i < n_threads; ++i) {
+			q.push_back (new PBD::WSDeque<ProcessNode*> (_trigger_queue.capacity ()));
+		}
+	}
+}
+
+void
+Graph::drop_thread_deques ()
+{
+	_work_stealing = false;
+	for (auto& q : _thread_deques) {
+		for (auto& d : q) {
+			delete d;
+		}
+		q.clear ();
+	}
 }
 
 void
@@ -205,6 +254,17 @@ Graph::prep ()
 	}
 	_graph_empty = true;
 
+	if (node_timing_enabled ()) {
+		/* prep() is called once for each chain that is processed,
+		 * and a session may process several times per engine cycle.
+		 */
+		samplepos_t const cycle_start = _session.engine ().sample_time_at_cycle_start ();
+		if (cycle_start != _cycle_cnt_start) {
+			_cycle_cnt_start = cycle_start;
+			++_cycle_cnt;
+		}
+	}
+
 	node_list_t::iterator i;
 	for (auto const& i : _graph_chain->_nodes_rt) {
 		i->prep (_graph_chain);
@@ -217,23 +277,110 @@ Graph::prep ()
 	if (_trigger_queue.capacity () < _graph_chain->_nodes_rt.size ()) {
 		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
 	}
+	for (auto& q : _priority_queue) {
+		if (q.capacity () < _graph_chain->_nodes_rt.size ()) {
+			q.reserve (_graph_chain->_nodes_rt.size ());
+		}
+	}
+
+	/* All threads are idle, and all deques are empty at this point.
+	 * It is safe to change scheduling mode for the next cycle.
+	 */
+	_work_stealing = Config->get_graph_work_stealing () && _thread_deques[0].size () > 1;
+
+	if (_work_stealing) {
+		for (auto& q : _thread_deques) {
+			for (auto& d : q) {
+				assert (d->empty ());
+				if (d->capacity () < _graph_chain->_nodes_rt.size ()) {
+					d->reserve (_graph_chain->_nodes_rt.size ());
+				}
+			}
+		}
+	}
 
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
 
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
 	for (auto const& i : _graph_chain->_init_trigger_list) {
 		_trigger_queue_size.fetch_add (1);
-		_trigger_queue.push_back (i.get ());
+		queue_shared (i.get (), i->graph_priority (_graph_chain));
 	}
 }
 
 void
-Graph::trigger (ProcessNode* n)
+Graph::trigger (ProcessNode* n, int priority)
 {
+	assert (priority >= 0 && priority < GraphChain::n_priority_levels);
 	_trigger_queue_size.fetch_add (1);
+
+	/* Keep the node on the thread that completed its last input,
+	 * it will be processed next by this thread, unless it is stolen.
+	 */
+	if (_work_stealing && graph_thread_slot >= 0 && _thread_deques[priority][graph_thread_slot]->push_back (n)) {
+		return;
+	}
+
+	queue_shared (n, priority);
+}
+
+void
+Graph::queue_shared (ProcessNode* n, int priority)
+{
+	assert (priority >= 0 && priority < GraphChain::n_priority_levels);
+	if (priority > 0 && _priority_queue[priority - 1].push_back (n)) {
+		return;
+	}
 	_trigger_queue.push_back (n);
 }
 
+/** Pop the node with the highest priority from the shared queues */
+bool
+Graph::pop_shared (ProcessNode*& to_run)
+{
+	for (int p = GraphChain::n_priority_levels - 2; p >= 0; --p) {
+		if (_priority_queue[p].pop_front (to_run)) {
+			return true;
+		}
+	}
+	return _trigger_queue.pop_front (to_run);
+}
+
+/** Find a node to process, highest priority first. At each priority
+ * level prefer nodes queued by this thread, then the shared queue, and
+ * finally steal from other threads.
+ */
+bool
+Graph::pop_work (ProcessNode*& to_run)
+{
+	if (!_work_stealing) {
+		return pop_shared (to_run);
+	}
+
+	int const n_deques = _thread_deques[0].size ();
+
+	for (int p = GraphChain::n_priority_levels - 1; p >= 0; --p) {
+		std::vector<PBD::WSDeque<ProcessNode*>*> const& q (_thread_deques[p]);
+
+		if (graph_thread_slot >= 0 && q[graph_thread_slot]->pop_back (to_run)) {
+			return true;
+		}
+
+		if (p > 0 ? _priority_queue[p - 1].pop_front (to_run) : _trigger_queue.pop_front (to_run)) {
+			return true;
+		}
+
+		/* start with the next thread's deque, to spread out thieves */
+		for (int i = 1; i <= n_deques; ++i) {
+			int victim = (graph_thread_slot + i) % n_deques;
+			if (victim != graph_thread_slot && q[victim]->steal (to_run)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
  *  is finished.
  */
@@ -295,7 +442,7 @@ Graph::run_one ()
 		return;
 	}
 
-	if (_trigger_queue.pop_front (to_run)) {
+	if (pop_work (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
 		 * other threads.
@@ -328,7 +475,7 @@ Graph::run_one ()
 		PBD::atomic_dec_and_test (_idle_thread_cnt);
 
 		/* Try to find some work to do */
-		_trigger_queue.pop_front (to_run);
+		pop_work (to_run);
 	}
 
 	/* Update the thread-local tempo map ptr.
@@ -349,8 +496,10 @@ Graph::run_one ()
 void
 Graph::helper_thread ()
 {
-	_n_workers.fetch_add (1);
-	uint32_t id = _n_workers.load();
+	uint32_t id = _n_workers.fetch_add (1) + 1;
+
+	assert (id < _thread_deques[0].size ());
+	graph_thread_slot = id;
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -382,6 +531,8 @@ Graph::main_thread ()
 {
 	/* first time setup */
 
+	graph_thread_slot = 0;
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 
@@ -536,6 +687,8 @@ Graph::process_one_route (Route* route)
 
 	assert (route);
 
+	PBD::microseconds_t start = node_timing_enabled () ? PBD::get_microseconds () : 0;
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 runs route %2\n", pthread_name (), route->name ()));
 
 	switch (_process_mode) {
@@ -558,12 +711,22 @@ Graph::process_one_route (Route* route)
 	if (need_butler) {
 		_process_need_butler = true; // -> atomic
 	}
+
+	if (start > 0) {
+		record_node_timing (route, start);
+	}
 }
 
 void
 Graph::process_one_ioplug (IOPlug* ioplug)
 {
+	PBD::microseconds_t start = node_timing_enabled () ? PBD::get_microseconds () : 0;
+
 	ioplug->connect_and_run (_process_start_sample, _process_nframes);
+
+	if (start > 0) {
+		record_node_timing (ioplug, start);
+	}
 }
 
 bool
@@ -601,21 +764,183 @@ Graph::process_tasklist (RTTaskList const& rt)
 
 /* ****************************************************************************/
 
+void
+Graph::record_node_timing (GraphNode const* node, PBD::microseconds_t start)
+{
+	if (graph_thread_slot < 0 || (size_t)graph_thread_slot >= _timing_rb.size ()) {
+		return;
+	}
+
+	GraphNodeTiming t;
+	t.node   = node;
+	t.thread = graph_thread_slot;
+	t.cycle  = _cycle_cnt;
+	t.queued = node->queued_at () > 0 ? node->queued_at () : start;
+	t.start  = start;
+	t.end    = PBD::get_microseconds ();
+
+	if (_timing_rb[graph_thread_slot]->write (&t, 1) != 1) {
+		_timing_dropped.fetch_add (1);
+	}
+}
+
+void
+Graph::start_node_timing ()
+{
+	Glib::Threads::Mutex::Lock lx (_timing_lock);
+	/* ensure that the graph is not running */
+	Glib::Threads::Mutex::Lock lm (_session.engine ().process_lock ());
+
+	_timing_enabled.store (0);
+
+	for (auto& rb : _timing_rb) {
+		delete rb;
+	}
+	_timing_rb.clear ();
+
+	/* one ringbuffer per process-thread, drained by drain_node_timing() */
+	for (size_t i = 0; i < _thread_deques[0].size (); ++i) {
+		_timing_rb.push_back (new PBD::RingBuffer<GraphNodeTiming> (65536));
+	}
+
+	_timing_log.clear ();
+	_timing_dropped.store (0);
+	_timing_enabled.store (1);
+}
+
+void
+Graph::stop_node_timing ()
+{
+	_timing_enabled.store (0);
+}
+
+/** Move recorded timing data from the realtime ringbuffers
+ * to the timing-log. This should be called periodically while
+ * timing is enabled, to prevent the ringbuffers from overflowing.
+ *
+ * @return number of events that were added to the log
+ */
+size_t
+Graph::drain_node_timing ()
+{
+	Glib::Threads::Mutex::Lock lx (_timing_lock);
+	size_t                     n = 0;
+
+	for (auto const& rb : _timing_rb) {
+		PBD::RingBuffer<GraphNodeTiming>::rw_vector vec;
+		rb->get_read_vector (&vec);
+		for (int i = 0; i < 2; ++i) {
+			_timing_log.insert (_timing_log.end (), vec.buf[i], vec.buf[i] + vec.len[i]);
+			n += vec.len[i];
+		}
+		rb->increment_read_idx (vec.len[0] + vec.len[1]);
+	}
+	return n;
+}
+
+static std::string
+json_escape (std::string const& s)
+{
+	std::string rv;
+	for (auto const& c : s) {
+		switch (c) {
+			case '"':
+				rv += "\\\"";
+				break;
+			case '\\':
+				rv += "\\\\";
+				break;
+			default:
+				if ((unsigned char)c < 0x20) {
+					char buf[8];
+					snprintf (buf, sizeof (buf), "\\u%04x", (unsigned char)c);
+					rv += buf;
+				} else {
+					rv += c;
+				}
+				break;
+		}
+	}
+	return rv;
+}
+
+/** Write collected per-node timing as Chrome trace-event JSON,
+ * which can be viewed with chrome://tracing or https://ui.perfetto.dev
+ */
+bool
+Graph::write_node_timing (std::string const& file_name)
+{
+	drain_node_timing ();
+
+	Glib::Threads::Mutex::Lock lx (_timing_lock);
+
+	/* resolve node names, nodes are only compared by address */
+	std::map<GraphNode const*, std::string> names;
+	std::shared_ptr<RouteList const>        rl (_session.get_routes ());
+	std::shared_ptr<IOPlugList const>       iop (_session.io_plugs ());
+	for (auto const& r : *rl) {
+		names[r.get ()] = r->name ();
+	}
+	for (auto const& p : *iop) {
+		names[p.get ()] = p->name ();
+	}
+
+	PBD::microseconds_t t0 = _timing_log.empty () ? 0 : _timing_log.front ().queued;
+	for (auto const& t : _timing_log) {
+		t0 = std::min (t0, std::min (t.queued, t.start));
+	}
+
+	stringstream ss;
+	ss << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":" << _timing_dropped.load () << "},\"traceEvents\":[\n";
+
+	bool first = true;
+	for (auto const& t : _timing_log) {
+		auto        it   = names.find (t.node);
+		std::string name = it == names.end () ? "(removed)" : it->second;
+		if (!first) {
+			ss << ",\n";
+		}
+		first = false;
+		ss << "{\"name\":\"" << json_escape (name) << "\",\"ph\":\"X\",\"pid\":0"
+		   << ",\"tid\":" << t.thread
+		   << ",\"ts\":" << (t.start - t0)
+		   << ",\"dur\":" << (t.end - t.start)
+		   << ",\"args\":{\"cycle\":" << t.cycle << ",\"wait\":" << (t.start - t.queued) << "}}";
+	}
+	ss << "\n]}\n";
+
+	GError* err = NULL;
+	if (!g_file_set_contents (file_name.c_str (), ss.str ().c_str (), -1, &err)) {
+		if (err) {
+			error << string_compose (_("Could not write graph timing to file (%1)"), err->message) << endmsg;
+			g_error_free (err);
+		}
+		return false;
+	}
+	return true;
+}
+
+/* ****************************************************************************/
+
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 {
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphChain constructed in thread:%1\n", pthread_name ()));
 	/* This will become the number of nodes that do not feed any other node;
 	 * once we have processed this number of those nodes, we have finished.
 	 */
-	_n_terminal_nodes = 0;
+	_n_terminal_nodes   = 0;
+	_critical_path_cost = 0;
 
 	/* copy nodelist to _nodes_rt, prepare GraphNodes for this graph */
 	for (auto const& ni : nodelist) {
 		RCUWriter<GraphActivision::ActivationMap>         wa (ni->_activation_set);
 		RCUWriter<GraphActivision::RefCntMap>             wr (ni->_init_refcount);
+		RCUWriter<GraphActivision::RefCntMap>             wp (ni->_graph_priority);
 		std::shared_ptr<GraphActivision::ActivationMap> ma (wa.get_copy ());
 		std::shared_ptr<GraphActivision::RefCntMap>     mr (wr.get_copy ());
+		std::shared_ptr<GraphActivision::RefCntMap>     mp (wp.get_copy ());
 		(*mr)[this] = 0;
+		(*mp)[this] = 0;
 		(*ma)[this].clear ();
 		_nodes_rt.push_back (ni);
 	}
@@ -658,9 +983,108 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 			_n_terminal_nodes += 1;
 		}
 	}
+
+	compute_priorities ();
 	dump ();
 }
 
+/* Longest cost-weighted path from the given node to the end of the graph,
+ * including the node itself. Results are memoized in `cp`.
+ */
+static double
+critical_path (GraphChain const* chain, GraphNode* node, std::map<GraphNode const*, double>& cp)
+{
+	auto it = cp.find (node);
+	if (it != cp.end ()) {
+		return it->second;
+	}
+
+	double downstream = 0;
+	for (auto const& ai : node->activation_set (chain)) {
+		downstream = std::max (downstream, critical_path (chain, ai.get (), cp));
+	}
+
+	double rv = std::max (0.0, node->graph_node_cost ()) + downstream;
+	cp[node] = rv;
+	return rv;
+}
+
+Glib::Threads::Mutex GraphChain::_priority_lock;
+
+bool
+GraphChain::compute_path_costs (std::map<GraphNode const*, double>& cp)
+{
+	_critical_path_cost = 0;
+
+	for (auto const& ni : _nodes_rt) {
+		_critical_path_cost = std::max (_critical_path_cost, critical_path (this, ni.get (), cp));
+	}
+
+	return _critical_path_cost > 0;
+}
+
+int
+GraphChain::priority_level (double path_cost) const
+{
+	int prio = floor (n_priority_levels * path_cost / _critical_path_cost);
+	return std::max (0, std::min (n_priority_levels - 1, prio));
+}
+
+/** Assign a dispatch priority to every node, so that ready nodes
+ * with the longest remaining path are processed first.
+ * This prevents deep bus hierarchies from serializing at the end of a cycle.
+ */
+void
+GraphChain::compute_priorities ()
+{
+	Glib::Threads::Mutex::Lock lm (_priority_lock);
+
+	std::map<GraphNode const*, double> cp;
+
+	if (!compute_path_costs (cp)) {
+		return;
+	}
+
+	for (auto const& ni : _nodes_rt) {
+		std::shared_ptr<GraphActivision::RefCntMap const> m (ni->_graph_priority.reader ());
+		auto mm = const_cast<GraphActivision::RefCntMap*> (&(*m));
+		(*mm)[this] = priority_level (cp[ni.get ()]);
+	}
+
+	/* longest path first */
+	_init_trigger_list.sort ([&cp] (node_ptr_t const& a, node_ptr_t const& b) {
+		return cp[a.get ()] > cp[b.get ()];
+	});
+}
+
+/** Plugin DSP load is only known after processing for a while, and
+ * changes when plugins are added, removed or bypassed, without the graph
+ * being rebuilt. This is called periodically to update the priorities of
+ * the chain in use. The order of initial nodes is retained, since it is
+ * used by the process thread.
+ */
+void
+GraphChain::refresh_priorities ()
+{
+	Glib::Threads::Mutex::Lock lm (_priority_lock);
+
+	std::map<GraphNode const*, double> cp;
+
+	if (!compute_path_costs (cp)) {
+		return;
+	}
+
+	for (auto const& ni : _nodes_rt) {
+		int const prio = priority_level (cp[ni.get ()]);
+		if (prio == ni->graph_priority (this)) {
+			continue;
+		}
+		RCUWriter<GraphActivision::RefCntMap>       wp (ni->_graph_priority);
+		std::shared_ptr<GraphActivision::RefCntMap> mp (wp.get_copy ());
+		(*mp)[this] = prio;
+	}
+}
+
 GraphChain::~GraphChain ()
 {
 	/* clear chain */
@@ -668,8 +1092,11 @@ GraphChain::~GraphChain ()
 	for (auto const& ni : _nodes_rt) {
 		RCUWriter<GraphActivision::ActivationMap>         wa (ni->_activation_set);
 		RCUWriter<GraphActivision::RefCntMap>             wr (ni->_init_refcount);
+		RCUWriter<GraphActivision::RefCntMap>             wp (ni->_graph_priority);
 		std::shared_ptr<GraphActivision::ActivationMap> ma (wa.get_copy ());
 		std::shared_ptr<GraphActivision::RefCntMap>     mr (wr.get_copy ());
+		std::shared_ptr<GraphActivision::RefCntMap>     mp (wp.get_copy ());
+		mp->erase (this);
 		mr->erase (this);
 		ma->erase (this);
 	}
@@ -726,7 +1153,7 @@ GraphChain::dump () const
 #ifndef NDEBUG
 	DEBUG_TRACE (DEBUG::Graph, "--8<-- Graph dump ----------------------------\n");
 	for (auto const& ni : _nodes_rt) {
-		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", ni->graph_node_name (), ni->init_refcount (this)));
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2 priority: %3\n", ni->graph_node_name (), ni->init_refcount (this), ni->graph_priority (this)));
 		for (auto const& ai : ni->activation_set (this)) {
 			DEBUG_TRACE (DEBUG::Graph, string_compose ("  triggers: %1\n", ai->graph_node_name ()));
 		}
@@ -738,6 +1165,7 @@ GraphChain::dump () const
 	}
 
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("final activation refcount: %1\n", _n_terminal_nodes));
+	DEBUG_TRACE (DEBUG::Graph, string_compose ("critical path cost: %1\n", _critical_path_cost));
 	DEBUG_TRACE (DEBUG::Graph, "-->8-- END Graph dump ------------------------\n");
 #endif
 }
@@ -29,6 +29,7 @@ using namespace ARDOUR;
 GraphActivision::GraphActivision ()
 	: _activation_set (new ActivationMap)
 	, _init_refcount (new RefCntMap)
+	, _graph_priority (new RefCntMap)
 {
 }
 
@@ -46,6 +47,13 @@ GraphActivision::init_refcount (GraphChain const* const g) const
 	return m->at (g);
 }
 
+int
+GraphActivision::graph_priority (GraphChain const* const g) const
+{
+	std::shared_ptr<RefCntMap const> m (_graph_priority.reader ());
+	return m->at (g);
+}
+
 void
 GraphActivision::flush_graph_activision_rcu ()
 {
@@ -56,6 +64,8 @@ GraphActivision::flush_graph_activision_rcu ()
 
 GraphNode::GraphNode (std::shared_ptr<Graph> graph)
 	: _graph (graph)
+	, _priority (0)
+	, _queued_at (0)
 {
 	_refcount.store (0);
 }
@@ -65,6 +75,12 @@ GraphNode::prep (GraphChain const* chain)
 {
 	/* This is the number of nodes that directly feed us */
 	_refcount.store (init_refcount (chain));
+	_priority = graph_priority (chain);
+
+	if (_graph->node_timing_enabled ()) {
+		/* initial nodes are queued right away */
+		_queued_at = PBD::get_microseconds ();
+	}
 }
 
 void
@@ -85,7 +101,10 @@ GraphNode::trigger ()
 		_refcount.store (_init_refcount[chain]);
 #endif
 		/* All nodes that feed this node have completed, so this node be processed now. */
-		_graph->trigger (this);
+		if (_graph->node_timing_enabled ()) {
+			_queued_at = PBD::get_microseconds ();
+		}
+		_graph->trigger (this, _priority);
 	}
 }
 
@@ -628,6 +628,17 @@ IOPlug::direct_feeds_according_to_reality (std::shared_ptr<GraphNode> node, bool
 	return other->input()->connected_to (_output);
 }
 
+double
+IOPlug::graph_node_cost () const
+{
+	PBD::microseconds_t min, max;
+	double              avg, dev;
+	if (get_stats (min, max, avg, dev)) {
+		return 1.0 + avg;
+	}
+	return 10.0;
+}
+
 /* ****************************************************************************/
 
 bool
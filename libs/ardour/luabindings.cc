@@ -1925,6 +1925,8 @@ LuaBindings::common (lua_State* L)
 		.endClass ()
 
 		.deriveWSPtrClass <DiskWriter, DiskIOProcessor> ("DiskWriter")
+		.addStaticFunction ("capture_margin", &DiskWriter::capture_margin)
+		.addStaticFunction ("reset_capture_margin", &DiskWriter::reset_capture_margin)
 		.endClass ()
 
 		.deriveWSPtrClass <IOProcessor, Processor> ("IOProcessor")
@@ -3004,6 +3006,10 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("freewheeling", &AudioEngine::freewheeling)
 		.addFunction ("running", &AudioEngine::running)
 		.addFunction ("processed_samples", &AudioEngine::processed_samples)
+		.addFunction ("start_benchmark", &AudioEngine::start_benchmark)
+		.addFunction ("benchmark_done", &AudioEngine::benchmark_done)
+		.addFunction ("benchmark_report", &AudioEngine::benchmark_report)
+		.addFunction ("benchmark_underruns", &AudioEngine::benchmark_underruns)
 		.endClass()
 
 		.deriveClass <VCAManager, PBD::StatefulDestructible> ("VCAManager")
@@ -3109,6 +3115,10 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_stripables", (StripableList (Session::*)() const)&Session::get_stripables)
 		.addFunction ("get_routelist", &Session::get_routelist)
 		.addFunction ("plot_process_graph", &Session::plot_process_graph)
+		.addFunction ("start_process_graph_timing", &Session::start_process_graph_timing)
+		.addFunction ("stop_process_graph_timing", &Session::stop_process_graph_timing)
+		.addFunction ("collect_process_graph_timing", &Session::collect_process_graph_timing)
+		.addFunction ("write_process_graph_timing", &Session::write_process_graph_timing)
 
 		.addFunction ("bundles", &Session::bundles)
 
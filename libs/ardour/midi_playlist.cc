@@ -23,6 +23,8 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <set>
 #include <utility>
 
 #include "evoral/EventList.h"
@@ -50,6 +52,10 @@ using namespace std;
 MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
+	, _render_layered (false)
+	, _render_filter (0)
+	, _render_filter_mode_mask (0)
+	, _render_note_mode (Sustained)
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -68,12 +74,20 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
+	, _render_layered (false)
+	, _render_filter (0)
+	, _render_filter_mode_mask (0)
+	, _render_note_mode (Sustained)
 {
 }
 
 MidiPlaylist::MidiPlaylist (std::shared_ptr<const MidiPlaylist> other, string name, bool hidden)
 	: Playlist (other, name, hidden)
 	, _note_mode(other->_note_mode)
+	, _render_layered (false)
+	, _render_filter (0)
+	, _render_filter_mode_mask (0)
+	, _render_note_mode (Sustained)
 {
 }
 
@@ -84,6 +98,10 @@ MidiPlaylist::MidiPlaylist (std::shared_ptr<const MidiPlaylist> other,
                             bool                                  hidden)
 	: Playlist (other, start, dur, name, hidden)
 	, _note_mode(other->_note_mode)
+	, _render_layered (false)
+	, _render_filter (0)
+	, _render_filter_mode_mask (0)
+	, _render_note_mode (Sustained)
 {
 }
 
@@ -269,10 +287,33 @@ MidiPlaylist::contained_automation()
 	return ret;
 }
 
+void
+MidiPlaylist::copy_rendered (std::shared_ptr<MidiRegion> const& mr, Evoral::EventList<samplepos_t>& dst, samplepos_t start, samplepos_t end) const
+{
+	RenderCache::const_iterator c = _render_cache.find (mr.get ());
+
+	if (c == _render_cache.end () || c->second.events->empty () || c->second.last < start || c->second.first >= end) {
+		return;
+	}
+
+	RTMidiBuffer const& events (*c->second.events);
+
+	for (size_t n = 0; n < events.size (); ++n) {
+		RTMidiBuffer::Item const& item (events[n]);
+		if (item.timestamp < start || item.timestamp >= end) {
+			continue;
+		}
+		uint32_t       size;
+		uint8_t const* data = events.bytes (item, size);
+		dst.write (item.timestamp, Evoral::MIDI_EVENT, size, data);
+	}
+}
+
 void
 MidiPlaylist::render (MidiChannelFilter* filter)
 {
 	Playlist::RegionReadLock rl (this);
+	Glib::Threads::Mutex::Lock lm (_render_lock);
 
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render (regions: %1)-----\n", regions.size()));
 
@@ -298,24 +339,92 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 		regs.push_back (mr);
 	}
 
-	/* RAII */
-	RTMidiBuffer::WriteProtectRender wpr (_rendered);
+	/* Each region's events are cached as last rendered. A change of the
+	 * tempo-map, channel-filter or note-mode affects all of them.
+	 */
 
-	if (regs.empty()) {
-		wpr.acquire ();
-		_rendered.clear ();
-		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
-		return;
+	Temporal::TempoMap::SharedPtr tmap = Temporal::TempoMap::use ();
+	uint32_t mode_mask = 0;
+
+	if (filter) {
+		ChannelMode mode;
+		uint16_t    mask;
+		filter->get_mode_and_mask (&mode, &mask);
+		mode_mask = ((uint32_t) mode << 16) | mask;
 	}
 
-	if (regs.size() == 1) {
-		wpr.acquire ();
-		_rendered.clear ();
-		std::shared_ptr<MidiRegion> mr = regs.front ();
+	bool full = false;
+
+	if (tmap != _render_tempo_map || filter != _render_filter || mode_mask != _render_filter_mode_mask || _note_mode != _render_note_mode) {
+		_render_cache.clear ();
+		_render_tempo_map        = tmap;
+		_render_filter           = filter;
+		_render_filter_mode_mask = mode_mask;
+		_render_note_mode        = _note_mode;
+		full = true;
+	}
+
+	/* re-render regions that changed, and find the time-range that is
+	 * affected by them, before and after the change.
+	 */
+
+	samplepos_t dirty_start = max_samplepos;
+	samplepos_t dirty_end   = 0;
+
+	auto extend = [&dirty_start, &dirty_end] (RenderedRegion const& rr) {
+		if (!rr.events->empty ()) {
+			dirty_start = std::min (dirty_start, rr.first);
+			dirty_end   = std::max (dirty_end, rr.last + 1);
+		}
+	};
+
+	std::set<MidiRegion const*> current;
+
+	for (auto const& mr : regs) {
+
+		current.insert (mr.get ());
+
+		RenderCache::iterator c = _render_cache.find (mr.get ());
+
+		if (c != _render_cache.end ()) {
+			RenderedRegion const& rr (c->second);
+			if (rr.generation == mr->render_generation () && rr.position == mr->position () && rr.start == mr->start () && rr.length == mr->length () && rr.layer == mr->layer ()) {
+				continue;
+			}
+			extend (rr);
+		}
+
+		RenderedRegion& rr (_render_cache[mr.get ()]);
+
+		rr.region     = mr;
+		rr.generation = mr->render_generation ();
+		rr.position   = mr->position ();
+		rr.start      = mr->start ();
+		rr.length     = mr->length ();
+		rr.layer      = mr->layer ();
+		rr.events.reset (new RTMidiBuffer);
+
 		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", mr->name()));
-		mr->render (_rendered, 0, _note_mode, filter);
-		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
-		return;
+		mr->render (*rr.events, 0, _note_mode, filter);
+
+		rr.first = max_samplepos;
+		rr.last  = 0;
+		for (size_t n = 0; n < rr.events->size (); ++n) {
+			rr.first = std::min (rr.first, (*rr.events)[n].timestamp);
+			rr.last  = std::max (rr.last, (*rr.events)[n].timestamp);
+		}
+
+		extend (rr);
+	}
+
+	for (RenderCache::iterator c = _render_cache.begin (); c != _render_cache.end ();) {
+		if (current.find (c->first) == current.end ()) {
+			/* removed, muted, or not solo-selected */
+			extend (c->second);
+			c = _render_cache.erase (c);
+		} else {
+			++c;
+		}
 	}
 
 	RegionSortByLayer cmp;
@@ -324,32 +433,51 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 	bool all_transparent = true;
 	bool no_layers = true;
 
-	layer_t layer = regs.front()->layer ();
+	if (regs.size () > 1) {
+		layer_t layer = regs.front()->layer ();
 
-	/* skip bottom-most region, transparency is irrelevant */
-	for (auto i = ++regs.begin(); i != regs.end(); ++i) {
-		if ((*i)->opaque ()) {
-			all_transparent = false;
-		}
-		if ((*i)->layer () != layer) {
-			no_layers = false;
-		}
-		if (!all_transparent && !no_layers) {
-			/* no need to check further */
-			break;
+		/* skip bottom-most region, transparency is irrelevant */
+		for (auto i = ++regs.begin(); i != regs.end(); ++i) {
+			if ((*i)->opaque ()) {
+				all_transparent = false;
+			}
+			if ((*i)->layer () != layer) {
+				no_layers = false;
+			}
+			if (!all_transparent && !no_layers) {
+				/* no need to check further */
+				break;
+			}
 		}
 	}
 
+	bool const layered = !all_transparent && !no_layers;
+
+	/* opaque layered regions hide each other, the result is not a plain merge */
+	if (layered || layered != _render_layered || _rendered.reversed ()) {
+		full = true;
+	}
+
+	_render_layered = layered;
+
+	if (!full && dirty_start >= dirty_end) {
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, unchanged, events: %1\n", _rendered.size()));
+		return;
+	}
+
+	if (full) {
+		dirty_start = std::numeric_limits<samplepos_t>::min ();
+		dirty_end   = max_samplepos;
+	}
+
 	Evoral::EventList<samplepos_t> evlist;
 
-	if (all_transparent || no_layers) {
+	if (!layered) {
 
-		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 regions to read\n", regs.size()));
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("\t%1 regions to read, range %2 .. %3\n", regs.size(), dirty_start, dirty_end));
 
 		for (auto i = regs.rbegin(); i != regs.rend(); ++i) {
-			std::shared_ptr<MidiRegion> mr = *i;
-			DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", mr->name()));
-			mr->render (evlist, 0, _note_mode, filter);
+			copy_rendered (*i, evlist, dirty_start, dirty_end);
 		}
 		EventsSortByTimeAndType<samplepos_t> cmp;
 		evlist.sort (cmp);
@@ -369,11 +497,11 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 
 			if (top) {
 				/* render topmost region as-is */
-				mr->render (evlist, 0, _note_mode, filter);
+				copy_rendered (mr, evlist, dirty_start, dirty_end);
 				top = false;
 			} else {
 				Evoral::EventList<samplepos_t> tmp;
-				mr->render (tmp, 0, _note_mode, filter);
+				copy_rendered (mr, tmp, dirty_start, dirty_end);
 
 				/* insert region-bound markers of opaque regions above */
 				for (auto const& p : bounds) {
@@ -416,16 +544,30 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 		}
 	}
 
-	wpr.acquire ();
-	_rendered.clear ();
+	/* Assemble the result outside of the lock: unchanged events before and
+	 * after the affected range are copied from the current render.
+	 */
+	RTMidiBuffer result;
+
+	if (!full) {
+		result.append (_rendered, std::numeric_limits<samplepos_t>::min (), dirty_start);
+	}
 
-	/* Copy ordered events from event list to _rendered. */
 	for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
 		Evoral::Event<samplepos_t>* ev (*e);
-		_rendered.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
+		result.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
 		delete ev;
 	}
 
+	if (!full) {
+		result.append (_rendered, dirty_end, max_samplepos);
+	}
+
+	/* RAII */
+	RTMidiBuffer::WriteProtectRender wpr (_rendered);
+	wpr.acquire ();
+	_rendered.swap (result);
+
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
 }
 
@@ -69,6 +69,7 @@ namespace PBD {
 MidiRegion::MidiRegion (const SourceList& srcs)
 	: Region (srcs)
 	, _ignore_shift (false)
+	, _render_generation (0)
 {
 	/* by default MIDI regions are transparent,
 	 * this should probably be set depending on use-case,
@@ -85,6 +86,7 @@ MidiRegion::MidiRegion (const SourceList& srcs)
 MidiRegion::MidiRegion (std::shared_ptr<const MidiRegion> other)
 	: Region (other)
 	, _ignore_shift (false)
+	, _render_generation (0)
 {
 	assert(_name.val().find("/") == string::npos);
 	midi_source(0)->ModelChanged.connect_same_thread (_source_connection, std::bind (&MidiRegion::model_changed, this));
@@ -95,6 +97,7 @@ MidiRegion::MidiRegion (std::shared_ptr<const MidiRegion> other)
 MidiRegion::MidiRegion (std::shared_ptr<const MidiRegion> other, timecnt_t const & offset)
 	: Region (other, offset)
 	, _ignore_shift (false)
+	, _render_generation (0)
 {
 
 	assert(_name.val().find("/") == string::npos);
@@ -442,6 +445,8 @@ MidiRegion::midi_source (uint32_t n) const
 void
 MidiRegion::model_changed ()
 {
+	_render_generation.fetch_add (1);
+
 	if (!model()) {
 		return;
 	}
@@ -472,6 +477,7 @@ MidiRegion::model_changed ()
 void
 MidiRegion::model_contents_changed ()
 {
+	_render_generation.fetch_add (1);
 	send_change (Properties::contents);
 }
 
@@ -482,6 +488,8 @@ MidiRegion::model_shifted (timecnt_t distance)
 		return;
 	}
 
+	_render_generation.fetch_add (1);
+
 	if (!_ignore_shift) {
 		PropertyChange what_changed;
 		/* _length is a Property, so we cannot call timepos_t methods on
@@ -516,6 +524,8 @@ MidiRegion::model_automation_state_changed (Evoral::Parameter const & p)
 		_filtered_parameters.insert (p);
 	}
 
+	_render_generation.fetch_add (1);
+
 	/* the source will have an iterator into the model, and that iterator will have been set up
 	   for a given set of filtered_parameters, so now that we've changed that list we must invalidate
 	   the iterator.
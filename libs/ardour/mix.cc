@@ -145,6 +145,50 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+void
+default_apply_gain_vector_to_buffer (ARDOUR::Sample * buf, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] *= gain[i];
+	}
+}
+
+void
+default_mix_buffers_with_gain_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		dst[i] += src[i] * gain[i];
+	}
+}
+
+float
+default_sum_of_squares (const ARDOUR::Sample * buf, pframes_t nframes)
+{
+	float sum = 0;
+	for (pframes_t i = 0; i < nframes; ++i) {
+		sum += buf[i] * buf[i];
+	}
+	return sum;
+}
+
+void
+default_interleave_channel (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	dst += channel;
+	for (pframes_t i = 0; i < nframes; ++i, dst += n_channels) {
+		*dst = src[i];
+	}
+}
+
+void
+default_deinterleave_channel (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	src += channel;
+	for (pframes_t i = 0; i < nframes; ++i, src += n_channels) {
+		dst[i] = *src;
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -187,6 +231,26 @@ veclib_mix_buffers_no_gain (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pf
 	vDSP_vsma(src, 1, &gain, dst, 1, dst, 1, nframes);
 }
 
+void
+veclib_apply_gain_vector_to_buffer (ARDOUR::Sample * buf, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	vDSP_vmul(buf, 1, gain, 1, buf, 1, nframes);
+}
+
+void
+veclib_mix_buffers_with_gain_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const ARDOUR::gain_t * gain, pframes_t nframes)
+{
+	vDSP_vma(src, 1, gain, 1, dst, 1, dst, 1, nframes);
+}
+
+float
+veclib_sum_of_squares (const ARDOUR::Sample * buf, pframes_t nframes)
+{
+	float sum = 0.0f;
+	vDSP_svesq(buf, 1, &sum, nframes);
+	return sum;
+}
+
 #endif
 
 
@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef COMPILER_MSVC
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/scoped_file_descriptor.h"
+
+#include "ardour/debug.h"
+#include "ardour/peak_pyramid.h"
+
+#include "pbd/i18n.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char pyramid_magic[8] = { 'A', 'R', 'D', 'P', 'E', 'A', 'K', 'S' };
+
+PeakPyramid::PeakPyramid (std::string const& path, samplecnt_t samples_per_peak)
+	: _path (path)
+	, _samples_per_peak (samples_per_peak)
+	, _fd (-1)
+	, _broken (false)
+{
+	init_header (_header, samples_per_peak);
+	for (uint32_t l = 0; l <= n_levels; ++l) {
+		_acc[l].cnt       = 0;
+		_next[l]          = 0;
+		_pending_start[l] = 0;
+	}
+}
+
+PeakPyramid::~PeakPyramid ()
+{
+	close ();
+}
+
+void
+PeakPyramid::init_header (Header& h, samplecnt_t samples_per_peak)
+{
+	memset (&h, 0, sizeof (Header));
+	memcpy (h.magic, pyramid_magic, sizeof (h.magic));
+	h.version          = version;
+	h.samples_per_peak = samples_per_peak;
+	h.factor           = factor;
+	h.n_levels         = n_levels;
+	h.block_peaks      = block_peaks;
+}
+
+bool
+PeakPyramid::check_header (Header const& h, samplecnt_t samples_per_peak)
+{
+	return 0 == memcmp (h.magic, pyramid_magic, sizeof (h.magic))
+		&& h.version == version
+		&& h.samples_per_peak == samples_per_peak
+		&& h.factor == factor
+		&& h.n_levels == n_levels
+		&& h.block_peaks == block_peaks;
+}
+
+off_t
+PeakPyramid::level_offset (uint32_t level, uint64_t index)
+{
+	/* each block holds block_peaks / 4 level-1 entries,
+	 * followed by block_peaks / 16 level-2 entries, etc. */
+	uint64_t in_block = 0;
+	uint64_t block    = 0;
+	for (uint32_t l = 1; l <= n_levels; ++l) {
+		if (l < level) {
+			in_block += block_peaks / level_peaks (l);
+		}
+		block += block_peaks / level_peaks (l);
+	}
+	uint64_t const per_block = block_peaks / level_peaks (level);
+	return sizeof (Header) + ((index / per_block) * block + in_block + (index % per_block)) * sizeof (PeakData);
+}
+
+int
+PeakPyramid::open ()
+{
+	if (_fd >= 0) {
+		return 0;
+	}
+	if ((_fd = g_open (_path.c_str (), O_CREAT | O_RDWR, 0664)) == -1) {
+		error << string_compose (_("PeakPyramid: cannot open \"%1\" (%2)"), _path, strerror (errno)) << endmsg;
+		return -1;
+	}
+	return reset ();
+}
+
+void
+PeakPyramid::close ()
+{
+	if (_fd >= 0) {
+		::close (_fd);
+		_fd = -1;
+	}
+}
+
+int
+PeakPyramid::reset ()
+{
+	/* partial reductions cannot be recovered from disk, always start over */
+	if (ftruncate (_fd, 0)) {
+		/* not fatal, the header is rewritten below */
+	}
+	init_header (_header, _samples_per_peak);
+	for (uint32_t l = 0; l <= n_levels; ++l) {
+		_acc[l].cnt = 0;
+		_next[l]    = 0;
+		_pending[l].clear ();
+	}
+	_broken = false;
+	return write_header ();
+}
+
+int
+PeakPyramid::write_at (off_t pos, void const* data, size_t len)
+{
+	if (lseek (_fd, pos, SEEK_SET) != pos) {
+		error << string_compose (_("PeakPyramid: could not seek in \"%1\" (%2)"), _path, strerror (errno)) << endmsg;
+		return -1;
+	}
+	if (::write (_fd, data, len) != (ssize_t) len) {
+		error << string_compose (_("PeakPyramid: could not write \"%1\" (%2)"), _path, strerror (errno)) << endmsg;
+		return -1;
+	}
+	return 0;
+}
+
+int
+PeakPyramid::write_header ()
+{
+	return write_at (0, &_header, sizeof (Header));
+}
+
+void
+PeakPyramid::add (uint32_t level, PeakData const& pd)
+{
+	Accumulator& a (_acc[level]);
+
+	if (a.cnt == 0) {
+		a.peak = pd;
+	} else {
+		a.peak.min = min (a.peak.min, pd.min);
+		a.peak.max = max (a.peak.max, pd.max);
+	}
+
+	if (++a.cnt < factor) {
+		return;
+	}
+
+	if (_pending[level].empty ()) {
+		_pending_start[level] = _next[level];
+	}
+	_pending[level].push_back (a.peak);
+	++_next[level];
+	a.cnt = 0;
+
+	if (level < n_levels) {
+		add (level + 1, _pending[level].back ());
+	}
+}
+
+int
+PeakPyramid::flush ()
+{
+	for (uint32_t l = 1; l <= n_levels; ++l) {
+		std::vector<PeakData>& p (_pending[l]);
+		uint64_t const per_block = block_peaks / level_peaks (l);
+		uint64_t       idx       = _pending_start[l];
+		size_t         done      = 0;
+
+		/* write runs of consecutive entries, split at block boundaries */
+		while (done < p.size ()) {
+			size_t n = min<uint64_t> (p.size () - done, per_block - (idx % per_block));
+			if (write_at (level_offset (l, idx), &p[done], n * sizeof (PeakData))) {
+				return -1;
+			}
+			done += n;
+			idx  += n;
+		}
+		p.clear ();
+	}
+
+	/* the header is updated last, so readers never see
+	 * counts beyond the data that has been written */
+	return write_header ();
+}
+
+int
+PeakPyramid::append (PeakData const* peaks, size_t n, uint64_t first)
+{
+	if (_fd < 0 || _broken || n == 0) {
+		return 0;
+	}
+
+	if (first != _header.n_peaks) {
+		if (first == 0) {
+			DEBUG_TRACE (DEBUG::Peaks, string_compose ("PeakPyramid %1 restart\n", _path));
+			if (reset ()) {
+				return -1;
+			}
+		} else {
+			DEBUG_TRACE (DEBUG::Peaks, string_compose ("PeakPyramid %1 non-contiguous write at %2 (expected %3)\n", _path, first, _header.n_peaks));
+			_broken = true;
+			return 0;
+		}
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		add (1, peaks[i]);
+	}
+	_header.n_peaks += n;
+
+	return flush ();
+}
+
+int
+PeakPyramid::finish (std::string const& peakfile)
+{
+	if (_fd < 0) {
+		return -1;
+	}
+
+	if (_broken) {
+		close ();
+		return build (_path, peakfile, _samples_per_peak);
+	}
+
+	/* add partial reductions at the end */
+	for (uint32_t l = 1; l <= n_levels; ++l) {
+		Accumulator& a (_acc[l]);
+		if (a.cnt == 0) {
+			continue;
+		}
+		if (_pending[l].empty ()) {
+			_pending_start[l] = _next[l];
+		}
+		_pending[l].push_back (a.peak);
+		++_next[l];
+		a.cnt = 0;
+		if (l < n_levels) {
+			add (l + 1, _pending[l].back ());
+		}
+	}
+
+	_header.complete = 1;
+	int rv = flush ();
+	close ();
+	return rv;
+}
+
+int
+PeakPyramid::build (std::string const& path, std::string const& peakfile, samplecnt_t samples_per_peak)
+{
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building PeakPyramid %1 from %2\n", path, peakfile));
+
+	ScopedFileDescriptor sfd (g_open (peakfile.c_str (), O_RDONLY, 0444));
+	if (sfd < 0) {
+		return -1;
+	}
+
+	PeakPyramid pp (path, samples_per_peak);
+	if (pp.open ()) {
+		return -1;
+	}
+
+	const size_t                bufsize = 8192;
+	std::unique_ptr<PeakData[]> buf (new PeakData[bufsize]);
+	uint64_t                    pos = 0;
+
+	while (true) {
+		ssize_t n = ::read (sfd, buf.get (), bufsize * sizeof (PeakData));
+		if (n < 0) {
+			pp.close ();
+			::g_unlink (path.c_str ());
+			return -1;
+		}
+		n /= sizeof (PeakData);
+		if (n == 0) {
+			break;
+		}
+		if (pp.append (buf.get (), n, pos)) {
+			pp.close ();
+			::g_unlink (path.c_str ());
+			return -1;
+		}
+		pos += n;
+	}
+
+	return pp.finish (peakfile);
+}
+
+bool
+PeakPyramid::usable (std::string const& path, std::string const& peakfile, samplecnt_t samples_per_peak)
+{
+	GStatBuf pst;
+	GStatBuf sst;
+
+	if (g_stat (path.c_str (), &pst) || g_stat (peakfile.c_str (), &sst)) {
+		return false;
+	}
+
+	/* same slop as for peakfile vs. audio file, see AudioSource::initialize_peakfile */
+	if (sst.st_mtime > pst.st_mtime && (sst.st_mtime - pst.st_mtime > 6)) {
+		return false;
+	}
+
+	ScopedFileDescriptor sfd (g_open (path.c_str (), O_RDONLY, 0444));
+	if (sfd < 0) {
+		return false;
+	}
+
+	Header h;
+	if (::read (sfd, &h, sizeof (Header)) != sizeof (Header)) {
+		return false;
+	}
+
+	return check_header (h, samples_per_peak) && h.complete;
+}
+
+int
+PeakPyramid::read_peaks (std::string const& path, samplecnt_t samples_per_peak,
+                         PeakData* peaks, samplecnt_t npeaks,
+                         samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak)
+{
+	/* use the coarsest level that still has 4 or more entries per visual peak */
+	uint32_t level = n_levels;
+	while (level > 0 && samples_per_peak * level_peaks (level) * factor > samples_per_visual_peak) {
+		--level;
+	}
+	if (level == 0 || npeaks <= 0 || cnt <= 0) {
+		return 1;
+	}
+
+	GStatBuf statbuf;
+	if (g_stat (path.c_str (), &statbuf) || statbuf.st_size < (off_t) sizeof (Header)) {
+		return 1;
+	}
+
+	ScopedFileDescriptor sfd (g_open (path.c_str (), O_RDONLY, 0444));
+	if (sfd < 0) {
+		return 1;
+	}
+
+	Header h;
+	if (::read (sfd, &h, sizeof (Header)) != sizeof (Header)) {
+		return 1;
+	}
+
+	int rv = 1;
+
+	samplecnt_t const level_spp = samples_per_peak * level_peaks (level);
+	uint64_t const    entries   = h.complete
+		? (h.n_peaks + level_peaks (level) - 1) / level_peaks (level)
+		: h.n_peaks / level_peaks (level);
+
+	samplepos_t const end = start + cnt;
+
+	/* while writing, only the beginning is covered */
+	if (check_header (h, samples_per_peak) && (h.complete || end <= (samplepos_t) (entries * level_spp))) {
+
+		uint64_t const e0 = start / level_spp;
+		uint64_t const e1 = min<uint64_t> (entries, (end + level_spp - 1) / level_spp);
+		size_t const   n  = e1 > e0 ? e1 - e0 : 0;
+
+		std::unique_ptr<PeakData[]> staging (new PeakData[max<size_t> (n, 1)]);
+
+		uint64_t const per_block = block_peaks / level_peaks (level);
+		uint64_t       idx       = e0;
+		size_t         done      = 0;
+
+		rv = 0;
+
+		while (done < n) {
+			size_t const len = min<uint64_t> (n - done, per_block - (idx % per_block));
+			off_t const  off = level_offset (level, idx);
+			if (off + (off_t) (len * sizeof (PeakData)) > statbuf.st_size) {
+				rv = -1;
+				break;
+			}
+			/* only read the entries of the level in the requested range */
+			if (lseek (sfd, off, SEEK_SET) != off || ::read (sfd, &staging[done], len * sizeof (PeakData)) != (ssize_t) (len * sizeof (PeakData))) {
+				rv = -1;
+				break;
+			}
+			done += len;
+			idx  += len;
+		}
+
+		/* reduce to visual peaks */
+		for (samplecnt_t p = 0; rv == 0 && p < npeaks; ++p) {
+			double const s = start + p * samples_per_visual_peak;
+			double const e = min ((double) end, start + (p + 1) * samples_per_visual_peak);
+
+			int64_t a = (int64_t) floor (s / level_spp) - (int64_t) e0;
+			int64_t b = (int64_t) ceil (e / level_spp) - (int64_t) e0;
+			a = max<int64_t> (a, 0);
+			b = min<int64_t> (b, n);
+
+			if (s >= end || a >= b) {
+				peaks[p].min = peaks[p].max = 0;
+				continue;
+			}
+
+			PeakData pd = staging[a];
+			for (int64_t i = a + 1; i < b; ++i) {
+				pd.min = min (pd.min, staging[i].min);
+				pd.max = max (pd.max, staging[i].max);
+			}
+			peaks[p] = pd;
+		}
+
+		if (rv) {
+			error << string_compose (_("peak pyramid %1 is truncated"), path) << endmsg;
+		}
+	}
+
+	return rv;
+}
@@ -787,6 +787,7 @@ Playlist::add_region_internal (std::shared_ptr<Region> region, timepos_t const &
 	region->set_position_time_domain (time_domain());
 
 	regions.insert (upper_bound (regions.begin (), regions.end (), region, cmp), region);
+	_region_index.invalidate ();
 	all_regions.insert (region);
 
 	if (!holding_state ()) {
@@ -847,6 +848,7 @@ Playlist::remove_region_internal (std::shared_ptr<Region> region, ThawList& thaw
 		if (*i == region) {
 
 			regions.erase (i);
+			_region_index.invalidate ();
 
 			if (!holding_state ()) {
 				relayer ();
@@ -1679,6 +1681,10 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, std::weak_pt
 		return;
 	}
 
+	if (what_changed.contains (Properties::length) || what_changed.contains (Properties::region_fx) || what_changed.contains (Properties::time_domain)) {
+		_region_index.invalidate ();
+	}
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1946,6 +1952,10 @@ Playlist::find_regions_at (timepos_t const & pos)
 
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (_region_index.regions_at (regions.rlist (), pos, *rlist)) {
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->covers (pos)) {
 			rlist->push_back (r);
@@ -1961,6 +1971,10 @@ Playlist::regions_with_start_within (Temporal::Range range)
 	RegionReadLock              rlock (this);
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (_region_index.regions_with_start_within (regions.rlist (), range, *rlist)) {
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->position() >= range.start() && r->position() < range.end()) {
 			rlist->push_back (r);
@@ -1976,6 +1990,10 @@ Playlist::regions_with_end_within (Temporal::Range range)
 	RegionReadLock              rlock (this);
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (_region_index.regions_with_end_within (regions.rlist (), range, *rlist)) {
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->nt_last() >= range.start() && r->nt_last() < range.end()) {
 			rlist->push_back (r);
@@ -1997,6 +2015,10 @@ Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end
 {
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (_region_index.regions_touched (regions.rlist (), start, end, with_tail, *rlist)) {
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->coverage (start, end, with_tail) != Temporal::OverlapNone) {
 			rlist->push_back (r);
@@ -2006,6 +2028,47 @@ Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end
 	return rlist;
 }
 
+void
+Playlist::collect_regions_at (timepos_t const & pos, RegionVector& result)
+{
+	RegionReadLock rlock (this);
+
+	result.clear ();
+
+	if (_region_index.regions_at (regions.rlist (), pos, result)) {
+		return;
+	}
+
+	for (auto & r : regions) {
+		if (r->covers (pos)) {
+			result.push_back (r);
+		}
+	}
+}
+
+void
+Playlist::collect_regions_touched (timepos_t const & start, timepos_t const & end, RegionVector& result, bool with_tail)
+{
+	RegionReadLock rlock (this);
+	collect_regions_touched_locked (start, end, with_tail, result);
+}
+
+void
+Playlist::collect_regions_touched_locked (timepos_t const & start, timepos_t const & end, bool with_tail, RegionVector& result)
+{
+	result.clear ();
+
+	if (_region_index.regions_touched (regions.rlist (), start, end, with_tail, result)) {
+		return;
+	}
+
+	for (auto & r : regions) {
+		if (r->coverage (start, end, with_tail) != Temporal::OverlapNone) {
+			result.push_back (r);
+		}
+	}
+}
+
 samplepos_t
 Playlist::find_next_transient (timepos_t const & from, int dir)
 {
@@ -941,7 +941,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 			if (clist && (static_cast<AutomationList const&> (*clist)).automation_playback ()) {
 				/* 1. Set value at [sub]cycle start */
 				bool valid;
-				float val = c.list()->rt_safe_eval (timepos_t (start), valid);
+				float val = clist->rt_safe_eval (timepos_t (start), valid);
 
 				if (valid) {
 					c.set_value_unchecked(val);
@@ -963,7 +963,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 						break;
 					}
 					now = next_event.when;
-					const float val = c.list()->rt_safe_eval (now, valid);
+					const float val = clist->rt_safe_eval (now, valid);
 					if (valid) {
 						for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 							(*i)->set_parameter (clist->parameter().id(), val, now.samples() - start);
@@ -973,7 +973,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 #endif
 #if 1
 				/* 3. VST3: set value at cycle-end */
-				val = c.list()->rt_safe_eval (timepos_t (end), valid);
+				val = clist->rt_safe_eval (timepos_t (end), valid);
 				if (valid) {
 					for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 						(*i)->set_parameter (clist->parameter().id(), val, end - start);
@@ -18,12 +18,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <regex.h>
 
 #include "pbd/error.h"
 
 #include "ardour/port_engine_shared.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -33,6 +36,9 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _sources (new Sources)
+	, _mixed_cycle (0)
+	, _mixed_samples (0)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -97,6 +103,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_sources ();
 }
 
 int
@@ -126,6 +133,7 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_sources ();
 }
 
 
@@ -137,6 +145,72 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_sources ();
+}
+
+void
+BackendPort::update_sources ()
+{
+	if (!is_input () || type () != DataType::AUDIO) {
+		return;
+	}
+
+	{
+		RCUWriter<Sources>       writer (_sources);
+		std::shared_ptr<Sources> s = writer.get_copy ();
+
+		s->clear ();
+		for (auto const& p : _connections) {
+			Source src;
+			src.port     = p.get ();
+			src.data     = p->source_buffer ();
+			src.generate = p->generates_data ();
+			src.physical = p->is_physical ();
+			assert (src.data);
+			s->push_back (src);
+		}
+	}
+
+	_sources.flush ();
+}
+
+void
+BackendPort::mix_connections (Sample* dst, pframes_t n_samples)
+{
+	std::shared_ptr<Sources const> s = _sources.reader ();
+
+	/* The data of physical ports is set once per backend cycle.
+	 * Ports owned by the engine may be written to several times per
+	 * backend cycle (vari-speed, split cycles), their sum must not
+	 * be re-used.
+	 */
+	uint64_t const cycle = std::all_of (s->begin (), s->end (), [] (Source const& src) { return src.physical; }) ? _backend._process_cycle : 0;
+
+	if (cycle != 0 && cycle == _mixed_cycle && n_samples == _mixed_samples) {
+		/* already summed in this cycle */
+		return;
+	}
+
+	_mixed_cycle   = cycle;
+	_mixed_samples = n_samples;
+
+	if (s->empty ()) {
+		memset (dst, 0, n_samples * sizeof (Sample));
+		return;
+	}
+
+	Sources::const_iterator i = s->begin ();
+	if (i->generate) {
+		i->port->get_buffer (n_samples);
+	}
+	copy_vector (dst, i->data, n_samples);
+
+	while (++i != s->end ()) {
+		if (i->generate) {
+			i->port->get_buffer (n_samples);
+		}
+		mix_buffers_no_gain (dst, i->data, n_samples);
+	}
 }
 
 bool
@@ -269,6 +343,7 @@ BackendMIDIEvent::operator< (const BackendMIDIEvent &other) const {
 
 PortEngineSharedImpl::PortEngineSharedImpl (PortManager& mgr, std::string const & str)
 	: _instance_name (str)
+	, _process_cycle (0)
 	, _portmap (new PortMap)
 	, _ports (new PortIndex)
 	, _portregistry (new PortRegistry)
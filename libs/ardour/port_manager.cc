@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <set>
 #include <vector>
 
 #ifdef COMPILER_MSVC
@@ -32,6 +33,7 @@
 #include <glibmm/miscutils.h>
 
 #include "pbd/error.h"
+#include "pbd/malign.h"
 #include "pbd/strsplit.h"
 #include "pbd/unwind.h"
 
@@ -99,6 +101,66 @@ private:
 
 static FallOffCache falloff_cache;
 
+class PortManager::SharedInput
+{
+public:
+	SharedInput (std::string const& name, PortEngine::PortPtr const& ph)
+		: _name (name)
+		, _handle (ph)
+		, _data (0)
+	{
+		_src.setup (Port::resampler_quality ());
+		_src.set_rrfilt (10);
+	}
+
+	~SharedInput ()
+	{
+		if (_data) cache_aligned_free (_data);
+	}
+
+	std::string const& name () const { return _name; }
+	Sample const*      data () const { return _data; }
+
+	void set_buffer_size (pframes_t nframes)
+	{
+		if (_data) cache_aligned_free (_data);
+		cache_aligned_malloc ((void**) &_data, sizeof (Sample) * lrint (floor (nframes * Config->get_max_transport_speed())));
+	}
+
+	void reinit (bool with_ratio)
+	{
+		if (with_ratio) {
+			_src.setup (Port::resampler_quality ());
+			_src.set_rrfilt (10);
+		}
+		_src.reset ();
+	}
+
+	/* same as AudioPort::cycle_start */
+	void process (PortEngine& pe, pframes_t nframes)
+	{
+		pframes_t const cycle_nframes = Port::cycle_nframes ();
+
+		_src.inp_data  = (float*)pe.get_buffer (_handle, nframes);
+		_src.inp_count = nframes;
+		_src.out_count = cycle_nframes;
+		_src.set_rratio (cycle_nframes / (double)nframes);
+		_src.out_data  = _data;
+		_src.process ();
+		while (_src.out_count > 0) {
+			*_src.out_data =  _src.out_data[-1];
+			++_src.out_data;
+			--_src.out_count;
+		}
+	}
+
+private:
+	std::string             _name;
+	PortEngine::PortPtr     _handle;
+	ArdourZita::VMResampler _src;
+	Sample*                 _data;
+};
+
 void
 PortManager::falloff_cache_calc (pframes_t n_samples, samplecnt_t rate)
 {
@@ -253,9 +315,13 @@ PortManager::PortManager ()
 	: _ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _cycle_port_list (new CyclePorts)
 	, _midi_info_dirty (true)
 	, _audio_input_ports (new AudioInputPorts)
 	, _midi_input_ports (new MIDIInputPorts)
+	, _audio_input_handles (new AudioInputHandles)
+	, _midi_input_handles (new MIDIInputHandles)
+	, _shared_inputs (new SharedInputs)
 {
 	_reset_meters.store (1);
 	load_port_info ();
@@ -298,6 +364,8 @@ PortManager::remove_session_ports ()
 		}
 	}
 
+	update_cycle_ports ();
+
 	/* clear dead wood list in RCU */
 
 	_ports.flush ();
@@ -544,15 +612,19 @@ PortManager::get_port_by_name (const string& portname)
 void
 PortManager::port_renamed (const std::string& old_relative_name, const std::string& new_relative_name)
 {
-	RCUWriter<Ports>         writer (_ports);
-	std::shared_ptr<Ports> p = writer.get_copy ();
-	Ports::iterator          x = p->find (old_relative_name);
+	{
+		RCUWriter<Ports>         writer (_ports);
+		std::shared_ptr<Ports> p = writer.get_copy ();
+		Ports::iterator          x = p->find (old_relative_name);
 
-	if (x != p->end ()) {
-		std::shared_ptr<Port> port = x->second;
-		p->erase (x);
-		p->insert (make_pair (new_relative_name, port));
+		if (x != p->end ()) {
+			std::shared_ptr<Port> port = x->second;
+			p->erase (x);
+			p->insert (make_pair (new_relative_name, port));
+		}
 	}
+
+	update_cycle_ports ();
 }
 
 int
@@ -656,11 +728,15 @@ PortManager::register_port (DataType dtype, const string& portname, bool input,
 
 		newport->set_buffer_size (AudioEngine::instance ()->samples_per_cycle ());
 
-		RCUWriter<Ports>         writer (_ports);
-		std::shared_ptr<Ports> ps = writer.get_copy ();
-		ps->insert (make_pair (make_port_name_relative (portname), newport));
+		{
+			RCUWriter<Ports>         writer (_ports);
+			std::shared_ptr<Ports> ps = writer.get_copy ();
+			ps->insert (make_pair (make_port_name_relative (portname), newport));
 
-		/* writer goes out of scope, forces update */
+			/* writer goes out of scope, forces update */
+		}
+
+		update_cycle_ports ();
 	}
 
 	catch (PortRegistrationFailure& err) {
@@ -711,6 +787,7 @@ PortManager::unregister_port (std::shared_ptr<Port> port)
 		/* writer goes out of scope, forces update */
 	}
 
+	update_cycle_ports ();
 	_ports.flush ();
 
 	return 0;
@@ -1001,6 +1078,13 @@ PortManager::connect_callback (const string& a, const string& b, bool conn)
 		}
 	}
 
+	if (port_a) {
+		update_shared_input (port_a);
+	}
+	if (port_b) {
+		update_shared_input (port_b);
+	}
+
 	PortConnectedOrDisconnected (
 	    port_a, a,
 	    port_b, b,
@@ -1151,6 +1235,8 @@ PortManager::update_input_ports (bool clear)
 		}
 	}
 
+	update_input_handles ();
+
 	if (clear) {
 		/* don't send notification for initial setup.
 		 * Physical I/O is initially connected in
@@ -1161,6 +1247,8 @@ PortManager::update_input_ports (bool clear)
 		/* .. but take the opportunity to clear out dead wood */
 		_audio_input_ports.flush ();
 		_midi_input_ports.flush ();
+		_audio_input_handles.flush ();
+		_midi_input_handles.flush ();
 		return;
 	}
 
@@ -1264,7 +1352,17 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	Port::set_global_port_buffer_offset (0);
 	Port::set_cycle_samplecnt (nframes);
 
-	_cycle_ports = _ports.reader ();
+	_cycle_ports         = _cycle_port_list.reader ();
+	_cycle_shared_inputs = _shared_inputs.reader ();
+
+	/* A single external source-port may be connected to many ardour
+	 * input-ports. Resample it only once, and let those ports use that data.
+	 */
+	for (auto const& si : *_cycle_shared_inputs) {
+		for (auto const& p : si.ports) {
+			p->set_shared_input (si.input->data ());
+		}
+	}
 
 	/* pre-calc/cache value */
 	falloff_cache.calc (nframes, s ? s->nominal_sample_rate () : 0);
@@ -1283,27 +1381,33 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	 *    many resamplers need to run) vs. available CPU cores and semaphore
 	 *    synchronization overhead.
 	 *
-	 *  - input ports: it would make sense to resample each input only once
-	 *    (rather than resample into each ardour-owned input port).
-	 *    A single external source-port may be connected to many ardour
-	 *    input-ports. Currently re-sampling is per input.
+	 *  - input ports that are connected to more than one port, or
+	 *    to other ardour-owned ports, still resample individually.
 	 */
 	std::shared_ptr<RTTaskList> tl;
 	if (s) {
 		tl = s->rt_tasklist ();
 	}
 	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
+		for (auto const& si : *_cycle_shared_inputs) {
+			tl->push_back (std::bind (&SharedInput::process, si.input, std::ref (port_engine ()), nframes));
+		}
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_start, p.second, nframes));
+			if (!(p->flags () & TransportSyncPort)) {
+				tl->push_back (std::bind (&Port::cycle_start, p, nframes));
 			}
 		}
 		tl->push_back (std::bind (&PortManager::run_input_meters, this, nframes, s ? s->nominal_sample_rate () : 0));
 		tl->process ();
 	} else {
+		/* serial fast path, notably when speed == 1.0 and the
+		 * resampler only copies data (and adds latency) */
+		for (auto const& si : *_cycle_shared_inputs) {
+			si.input->process (port_engine (), nframes);
+		}
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_start (nframes);
+			if (!(p->flags () & TransportSyncPort)) {
+				p->cycle_start (nframes);
 			}
 		}
 		run_input_meters (nframes, s ? s->nominal_sample_rate () : 0);
@@ -1320,15 +1424,15 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 	}
 	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_end, p.second, nframes));
+			if (!(p->flags () & TransportSyncPort)) {
+				tl->push_back (std::bind (&Port::cycle_end, p, nframes));
 			}
 		}
 		tl->process ();
 	} else {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_end (nframes);
+			if (!(p->flags () & TransportSyncPort)) {
+				p->cycle_end (nframes);
 			}
 		}
 	}
@@ -1336,10 +1440,11 @@ PortManager::cycle_end (pframes_t nframes, Session* s)
 	for (auto const& p : *_cycle_ports) {
 		/* AudioEngine::split_cycle flushes buffers until Port::port_offset.
 		 * Now only flush remaining events (after Port::port_offset) */
-		p.second->flush_buffers (nframes * Port::resample_ratio () - Port::port_offset ());
+		p->flush_buffers (nframes * Port::resample_ratio () - Port::port_offset ());
 	}
 
 	_cycle_ports.reset ();
+	_cycle_shared_inputs.reset ();
 
 	/* we are done */
 }
@@ -1348,20 +1453,20 @@ void
 PortManager::silence (pframes_t nframes, Session* s)
 {
 	for (auto const& p : *_cycle_ports) {
-		if (s && p.second == s->mtc_output_port ()) {
+		if (s && p == s->mtc_output_port ()) {
 			continue;
 		}
-		if (s && p.second == s->midi_clock_output_port ()) {
+		if (s && p == s->midi_clock_output_port ()) {
 			continue;
 		}
-		if (s && p.second == s->ltc_output_port ()) {
+		if (s && p == s->ltc_output_port ()) {
 			continue;
 		}
-		if (std::dynamic_pointer_cast<AsyncMIDIPort> (p.second)) {
+		if (std::dynamic_pointer_cast<AsyncMIDIPort> (p)) {
 			continue;
 		}
-		if (p.second->sends_output ()) {
-			p.second->get_buffer (nframes).silence (nframes);
+		if (p->sends_output ()) {
+			p->get_buffer (nframes).silence (nframes);
 		}
 	}
 }
@@ -1372,6 +1477,9 @@ PortManager::reinit (bool with_ratio)
 	for (auto const& p : *_ports.reader ()) {
 		p.second->reinit (with_ratio);
 	}
+	for (auto const& si : *_shared_inputs.reader ()) {
+		si.input->reinit (with_ratio);
+	}
 }
 
 void
@@ -1418,12 +1526,12 @@ PortManager::check_monitoring ()
 {
 	for (auto const& p : *_cycle_ports) {
 		bool x;
-		if (p.second->last_monitor () != (x = p.second->monitoring_input ())) {
-			p.second->set_last_monitor (x);
+		if (p->last_monitor () != (x = p->monitoring_input ())) {
+			p->set_last_monitor (x);
 			/* XXX I think this is dangerous, due to
 			   a likely mutex in the signal handlers ...
 			*/
-			p.second->MonitorInputChanged (x); /* EMIT SIGNAL */
+			p->MonitorInputChanged (x); /* EMIT SIGNAL */
 		}
 	}
 }
@@ -1438,24 +1546,24 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 	}
 	if (tl && fabs (Port::resample_ratio ()) != 1.0) {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				tl->push_back (std::bind (&Port::cycle_end, p.second, nframes));
+			if (!(p->flags () & TransportSyncPort)) {
+				tl->push_back (std::bind (&Port::cycle_end, p, nframes));
 			}
 		}
 		tl->process ();
 	} else {
 		for (auto const& p : *_cycle_ports) {
-			if (!(p.second->flags () & TransportSyncPort)) {
-				p.second->cycle_end (nframes);
+			if (!(p->flags () & TransportSyncPort)) {
+				p->cycle_end (nframes);
 			}
 		}
 	}
 
 	for (auto const& p : *_cycle_ports) {
-		p.second->flush_buffers (nframes);
+		p->flush_buffers (nframes);
 
-		if (p.second->sends_output ()) {
-			std::shared_ptr<AudioPort> ap = std::dynamic_pointer_cast<AudioPort> (p.second);
+		if (p->sends_output ()) {
+			std::shared_ptr<AudioPort> ap = std::dynamic_pointer_cast<AudioPort> (p);
 			if (ap) {
 				Sample* s = ap->engine_get_whole_audio_buffer ();
 				gain_t  g = base_gain;
@@ -1468,6 +1576,7 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 		}
 	}
 	_cycle_ports.reset ();
+	_cycle_shared_inputs.reset ();
 	/* we are done */
 }
 
@@ -1914,6 +2023,9 @@ PortManager::set_port_buffer_sizes (pframes_t n)
 	for (auto const& p : *all) {
 		p.second->set_buffer_size (n);
 	}
+	for (auto const& si : *_shared_inputs.reader ()) {
+		si.input->set_buffer_size (n);
+	}
 	_monitor_port.set_buffer_size (n);
 }
 
@@ -1969,6 +2081,187 @@ PortManager::midi_input_ports () const
 	return *p;
 }
 
+void
+PortManager::update_cycle_ports ()
+{
+	std::shared_ptr<Ports const> p = _ports.reader ();
+
+	{
+		RCUWriter<CyclePorts>       writer (_cycle_port_list);
+		std::shared_ptr<CyclePorts> cp = writer.get_copy ();
+
+		cp->clear ();
+		cp->reserve (p->size ());
+		for (auto const& i : *p) {
+			cp->push_back (i.second);
+		}
+	}
+
+	/* drop references to removed ports, see ::unregister_port */
+	_cycle_port_list.flush ();
+
+	/* likewise for ports that used a shared input */
+	std::set<Port const*> registered;
+	for (auto const& i : *p) {
+		registered.insert (i.second.get ());
+	}
+
+	bool stale = false;
+	for (auto const& si : *_shared_inputs.reader ()) {
+		for (auto const& ap : si.ports) {
+			stale |= registered.find (ap.get ()) == registered.end ();
+		}
+	}
+
+	if (!stale) {
+		return;
+	}
+
+	{
+		RCUWriter<SharedInputs>       writer (_shared_inputs);
+		std::shared_ptr<SharedInputs> si = writer.get_copy ();
+
+		for (auto i = si->begin (); i != si->end ();) {
+			i->ports.erase (std::remove_if (i->ports.begin (), i->ports.end (),
+			                                [&registered] (std::shared_ptr<AudioPort> const& ap) { return registered.find (ap.get ()) == registered.end (); }),
+			                i->ports.end ());
+			if (i->ports.empty ()) {
+				i = si->erase (i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	_shared_inputs.flush ();
+}
+
+void
+PortManager::update_shared_input (std::shared_ptr<Port> const& p)
+{
+	std::shared_ptr<AudioPort> ap = std::dynamic_pointer_cast<AudioPort> (p);
+
+	if (!ap || !ap->receives_input () || (ap->flags () & TransportSyncPort) || !_backend || !ap->port_handle ()) {
+		return;
+	}
+
+	/* The backend sums all connections of an input port. Only ports
+	 * with a single connection to an external port can share the data.
+	 */
+	std::string              source;
+	std::vector<std::string> c;
+
+	if (_backend->get_connections (ap->port_handle (), c) == 1 && !port_is_mine (c.front ())) {
+		source = c.front ();
+	}
+
+	/* check if anything changed, to retain resampler state */
+	std::string current;
+	for (auto const& si : *_shared_inputs.reader ()) {
+		if (std::find (si.ports.begin (), si.ports.end (), ap) != si.ports.end ()) {
+			current = si.input->name ();
+			break;
+		}
+	}
+
+	if (current == source) {
+		return;
+	}
+
+	PortEngine::PortPtr ph;
+	if (!source.empty ()) {
+		ph = _backend->get_port_by_name (source);
+	}
+
+	{
+		RCUWriter<SharedInputs>       writer (_shared_inputs);
+		std::shared_ptr<SharedInputs> si = writer.get_copy ();
+
+		bool added = false;
+		for (auto i = si->begin (); i != si->end ();) {
+			i->ports.erase (std::remove (i->ports.begin (), i->ports.end (), ap), i->ports.end ());
+			if (ph && i->input->name () == source) {
+				i->ports.push_back (ap);
+				added = true;
+			}
+			if (i->ports.empty ()) {
+				i = si->erase (i);
+			} else {
+				++i;
+			}
+		}
+
+		if (ph && !added) {
+			SharedInputPorts sip;
+			sip.input.reset (new SharedInput (source, ph));
+			sip.input->set_buffer_size (AudioEngine::instance ()->samples_per_cycle ());
+			sip.ports.push_back (ap);
+			si->push_back (sip);
+		}
+	}
+
+	_shared_inputs.flush ();
+}
+
+void
+PortManager::update_input_handles ()
+{
+	/* resolve port-names once, rather than in every process cycle */
+	std::shared_ptr<AudioInputPorts const> aip = _audio_input_ports.reader ();
+	std::shared_ptr<MIDIInputPorts const>  mip = _midi_input_ports.reader ();
+
+	{
+		RCUWriter<AudioInputHandles>       writer (_audio_input_handles);
+		std::shared_ptr<AudioInputHandles> ah = writer.get_copy ();
+
+		ah->clear ();
+		ah->reserve (aip->size ());
+		for (auto const& p : *aip) {
+			assert (!port_is_mine (p.first));
+			PortEngine::PortPtr ph = _backend->get_port_by_name (p.first);
+			if (ph) {
+				ah->push_back (make_pair (ph, p.second));
+			}
+		}
+	}
+
+	{
+		RCUWriter<MIDIInputHandles>       writer (_midi_input_handles);
+		std::shared_ptr<MIDIInputHandles> mh = writer.get_copy ();
+
+		mh->clear ();
+		mh->reserve (mip->size ());
+		for (auto const& p : *mip) {
+			assert (!port_is_mine (p.first));
+			PortEngine::PortPtr ph = _backend->get_port_by_name (p.first);
+			if (ph) {
+				mh->push_back (make_pair (ph, p.second));
+			}
+		}
+	}
+}
+
+void
+PortManager::drop_input_handles ()
+{
+	/* backend ports must not outlive the backend */
+	{
+		RCUWriter<AudioInputHandles> writer (_audio_input_handles);
+		writer.get_copy ()->clear ();
+	}
+	{
+		RCUWriter<MIDIInputHandles> writer (_midi_input_handles);
+		writer.get_copy ()->clear ();
+	}
+	{
+		RCUWriter<SharedInputs> writer (_shared_inputs);
+		writer.get_copy ()->clear ();
+	}
+	_audio_input_handles.flush ();
+	_midi_input_handles.flush ();
+	_shared_inputs.flush ();
+}
+
 void
 PortManager::run_input_meters (pframes_t n_samples, samplecnt_t rate)
 {
@@ -1981,21 +2274,18 @@ PortManager::run_input_meters (pframes_t n_samples, samplecnt_t rate)
 
 	_monitor_port.monitor (port_engine (), n_samples);
 
-	/* calculate peak of all physical inputs (readable ports) */
-	std::shared_ptr<AudioInputPorts const> aip = _audio_input_ports.reader ();
+	/* calculate peak of all physical inputs (readable ports).
+	 * AudioInputPort and MIDIInputPort share their meters with
+	 * the entries of _audio_input_ports and _midi_input_ports.
+	 */
+	std::shared_ptr<AudioInputHandles const> aih = _audio_input_handles.reader ();
 
-	for (auto const& p : *aip) {
-		assert (!port_is_mine (p.first));
+	for (auto const& p : *aih) {
 		AudioInputPort& ai = *const_cast<AudioInputPort*>(&p.second);
 
 		ai.apply_falloff (n_samples, rate, reset);
 
-		PortEngine::PortHandle ph = _backend->get_port_by_name (p.first);
-		if (!ph) {
-			continue;
-		}
-
-		Sample* buf = (Sample*)_backend->get_buffer (ph, n_samples);
+		Sample* buf = (Sample*)_backend->get_buffer (p.first, n_samples);
 		if (!buf) {
 			/* can this happen? */
 			ai.silence (n_samples);
@@ -2006,19 +2296,12 @@ PortManager::run_input_meters (pframes_t n_samples, samplecnt_t rate)
 	}
 
 	/* MIDI */
-	std::shared_ptr<MIDIInputPorts const> mip = _midi_input_ports.reader ();
-	for (auto const& p : *mip) {
-		assert (!port_is_mine (p.first));
-
-		PortEngine::PortHandle ph = _backend->get_port_by_name (p.first);
-		if (!ph) {
-			continue;
-		}
-
+	std::shared_ptr<MIDIInputHandles const> mih = _midi_input_handles.reader ();
+	for (auto const& p : *mih) {
 		MIDIInputPort& mi = *const_cast<MIDIInputPort*>(&p.second);
 		mi.apply_falloff (n_samples, rate, reset);
 
-		void*           buffer      = _backend->get_buffer (ph, n_samples);
+		void*           buffer      = _backend->get_buffer (p.first, n_samples);
 		const pframes_t event_count = _backend->get_midi_event_count (buffer);
 
 		for (pframes_t i = 0; i < event_count; ++i) {
@@ -2045,7 +2328,7 @@ void
 PortManager::list_cycle_ports () const
 {
 	for (auto const& p : *_cycle_ports) {
-		std::cout << p.first << "\n";
+		std::cout << p->name () << "\n";
 	}
 }
 #endif
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "ardour/process_benchmark.h"
+
+using namespace ARDOUR;
+
+ProcessBenchmark::ProcessBenchmark ()
+	: _n_recorded (0)
+	, _underruns (0)
+	, _running (false)
+	, _samples_per_cycle (0)
+	, _sample_rate (0)
+	, _first_start (0)
+	, _last_end (0)
+{
+}
+
+void
+ProcessBenchmark::start (uint32_t n_cycles, pframes_t samples_per_cycle, samplecnt_t sample_rate)
+{
+	_running.store (false);
+
+	/* allocate here, not in the process thread */
+	_cycles.assign (n_cycles, 0);
+	_n_recorded.store (0);
+	_underruns.store (0);
+
+	_samples_per_cycle = samples_per_cycle;
+	_sample_rate       = sample_rate;
+	_first_start       = 0;
+	_last_end          = 0;
+
+	_running.store (n_cycles > 0);
+}
+
+void
+ProcessBenchmark::reset ()
+{
+	_running.store (false);
+	_n_recorded.store (0);
+	_underruns.store (0);
+	_cycles.clear ();
+}
+
+void
+ProcessBenchmark::underrun ()
+{
+	if (_running.load ()) {
+		_underruns.fetch_add (1);
+	}
+}
+
+bool
+ProcessBenchmark::done () const
+{
+	return !_running.load () && !_cycles.empty () && _n_recorded.load () == _cycles.size ();
+}
+
+void
+ProcessBenchmark::record (PBD::microseconds_t start, PBD::microseconds_t end)
+{
+	uint32_t n = _n_recorded.load ();
+
+	if (n >= _cycles.size ()) {
+		_running.store (false);
+		return;
+	}
+
+	if (n == 0) {
+		_first_start = start;
+	}
+	_last_end  = end;
+	_cycles[n] = end - start;
+
+	_n_recorded.store (++n);
+
+	if (n == _cycles.size ()) {
+		_running.store (false);
+	}
+}
+
+std::string
+ProcessBenchmark::report () const
+{
+	uint32_t const n = _n_recorded.load ();
+
+	std::vector<PBD::microseconds_t> c (_cycles.begin (), _cycles.begin () + n);
+	std::sort (c.begin (), c.end ());
+
+	double const period_us = _sample_rate > 0 ? 1e6 * _samples_per_cycle / (double)_sample_rate : 0;
+
+	/* nearest-rank percentile */
+	auto percentile = [&c] (double p) -> PBD::microseconds_t {
+		if (c.empty ()) {
+			return 0;
+		}
+		size_t i = (size_t)ceil (p * c.size ());
+		return c[std::max<size_t> (i, 1) - 1];
+	};
+
+	double   sum   = 0;
+	uint32_t xruns = 0;
+	for (auto const& d : c) {
+		sum += d;
+		if (period_us > 0 && d > period_us) {
+			++xruns;
+		}
+	}
+
+	double const avg     = n > 0 ? sum / n : 0;
+	double const wall_s  = n > 0 ? (_last_end - _first_start) * 1e-6 : 0;
+	double const audio_s = _sample_rate > 0 ? n * _samples_per_cycle / (double)_sample_rate : 0;
+
+	/* DSP load in percent of the nominal period */
+	auto load = [period_us] (double us) {
+		return period_us > 0 ? 100.0 * us / period_us : 0;
+	};
+
+	std::stringstream ss;
+	ss << std::fixed << std::setprecision (3);
+	ss << "{\n"
+	   << "  \"cycles\": " << n << ",\n"
+	   << "  \"samples_per_cycle\": " << _samples_per_cycle << ",\n"
+	   << "  \"sample_rate\": " << _sample_rate << ",\n"
+	   << "  \"period_us\": " << period_us << ",\n"
+	   << "  \"wall_time_s\": " << wall_s << ",\n"
+	   << "  \"cycles_per_second\": " << (wall_s > 0 ? n / wall_s : 0) << ",\n"
+	   << "  \"realtime_factor\": " << (wall_s > 0 ? audio_s / wall_s : 0) << ",\n"
+	   << "  \"cycle_us\": {"
+	   << " \"min\": " << (c.empty () ? 0 : c.front ())
+	   << ", \"p50\": " << percentile (.5)
+	   << ", \"p99\": " << percentile (.99)
+	   << ", \"max\": " << (c.empty () ? 0 : c.back ())
+	   << ", \"avg\": " << avg
+	   << " },\n"
+	   << "  \"dsp_load\": {"
+	   << " \"p50\": " << load (percentile (.5))
+	   << ", \"p99\": " << load (percentile (.99))
+	   << ", \"max\": " << load (c.empty () ? 0 : c.back ())
+	   << ", \"avg\": " << load (avg)
+	   << " },\n"
+	   << "  \"xruns\": " << xruns << ",\n"
+	   << "  \"disk_underruns\": " << _underruns.load () << "\n"
+	   << "}\n";
+
+	return ss.str ();
+}
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/region.h"
+#include "ardour/region_index.h"
+
+using namespace ARDOUR;
+using namespace Temporal;
+
+RegionIndex::RegionIndex ()
+	: _dirty (true)
+	, _suspended (0)
+	, _beat_time (false)
+{
+}
+
+void
+RegionIndex::suspend ()
+{
+	_suspended.fetch_add (1);
+	_dirty.store (true);
+}
+
+void
+RegionIndex::resume ()
+{
+	_dirty.store (true);
+	_suspended.fetch_sub (1);
+}
+
+bool
+RegionIndex::prepare (RegionList const& regions)
+{
+	/* _lock is held */
+	if (_suspended.load () > 0 || regions.size () < min_regions) {
+		return false;
+	}
+	if (_dirty.exchange (false)) {
+		rebuild (regions);
+	}
+	_hits.clear ();
+	return true;
+}
+
+void
+RegionIndex::rebuild (RegionList const& regions)
+{
+	_by_start.clear ();
+	_by_last.clear ();
+	_with_tail.clear ();
+
+	_beat_time = regions.front ()->position ().time_domain () == BeatTime;
+
+	_by_start.reserve (regions.size ());
+	_by_last.reserve (regions.size ());
+	_hits.reserve (regions.size ());
+
+	uint32_t order = 0;
+	for (auto const& r : regions) {
+		Entry e;
+		e.start    = key (r->position ());
+		e.last     = key (r->nt_last ());
+		e.max_last = e.last;
+		e.order    = order++;
+		/* only regions with region-fx can have a tail,
+		 * adding/removing them invalidates the index.
+		 */
+		e.tail     = r->has_region_fx ();
+		e.region   = &r;
+		_by_start.push_back (e);
+	}
+
+	/* the RegionList is usually sorted by position already */
+	std::sort (_by_start.begin (), _by_start.end (), [] (Entry const& a, Entry const& b) {
+		return a.start < b.start || (a.start == b.start && a.order < b.order);
+	});
+
+	annotate (0, _by_start.size ());
+
+	for (auto const& e : _by_start) {
+		_by_last.push_back (&e);
+		if (e.tail) {
+			_with_tail.push_back (&e);
+		}
+	}
+
+	std::sort (_by_last.begin (), _by_last.end (), [] (Entry const* a, Entry const* b) {
+		return a->last < b->last;
+	});
+}
+
+int64_t
+RegionIndex::annotate (size_t lo, size_t hi)
+{
+	if (lo >= hi) {
+		return INT64_MIN;
+	}
+	size_t const mid = lo + (hi - lo) / 2;
+	Entry&       e   = _by_start[mid];
+
+	e.max_last = std::max (e.last, std::max (annotate (lo, mid), annotate (mid + 1, hi)));
+	return e.max_last;
+}
+
+void
+RegionIndex::find_overlapping (size_t lo, size_t hi, int64_t start, int64_t last, bool skip_tail)
+{
+	/* find all entries with e.start <= last && e.last >= start */
+	while (lo < hi) {
+		size_t const mid = lo + (hi - lo) / 2;
+		Entry const& e   = _by_start[mid];
+
+		if (e.max_last < start) {
+			/* nothing in this subtree reaches `start` */
+			return;
+		}
+
+		find_overlapping (lo, mid, start, last, skip_tail);
+
+		if (e.start > last) {
+			/* all of the right subtree starts later */
+			return;
+		}
+
+		if (e.last >= start && !(skip_tail && e.tail)) {
+			_hits.push_back (&e);
+		}
+
+		lo = mid + 1;
+	}
+}
+
+bool
+RegionIndex::find_at (RegionList const& regions, timepos_t const& pos)
+{
+	/* _lock is held */
+	if (!prepare (regions)) {
+		return false;
+	}
+
+	int64_t const k = key (pos);
+	find_overlapping (0, _by_start.size (), k, k, false);
+
+	/* keys are monotonic, but not strictly so. Apply exact test */
+	_hits.erase (std::remove_if (_hits.begin (), _hits.end (), [&pos] (Entry const* e) {
+		return !(*e->region)->covers (pos);
+	}), _hits.end ());
+
+	return true;
+}
+
+bool
+RegionIndex::find_touched (RegionList const& regions, timepos_t const& start, timepos_t const& end, bool with_tail)
+{
+	/* _lock is held */
+	if (!prepare (regions)) {
+		return false;
+	}
+
+	find_overlapping (0, _by_start.size (), key (start), key (end), with_tail);
+
+	if (with_tail) {
+		/* the tail of a region can change at any time,
+		 * check those regions individually */
+		int64_t const k = key (end);
+		for (auto const& e : _with_tail) {
+			if (e->start <= k) {
+				_hits.push_back (e);
+			}
+		}
+	}
+
+	_hits.erase (std::remove_if (_hits.begin (), _hits.end (), [&] (Entry const* e) {
+		return (*e->region)->coverage (start, end, with_tail) == Temporal::OverlapNone;
+	}), _hits.end ());
+
+	return true;
+}
+
+bool
+RegionIndex::regions_at (RegionList const& regions, timepos_t const& pos, RegionList& result)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	if (!find_at (regions, pos)) {
+		return false;
+	}
+	collect (result);
+	return true;
+}
+
+bool
+RegionIndex::regions_at (RegionList const& regions, timepos_t const& pos, RegionVector& result)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	if (!find_at (regions, pos)) {
+		return false;
+	}
+	collect (result);
+	return true;
+}
+
+bool
+RegionIndex::regions_touched (RegionList const& regions, timepos_t const& start, timepos_t const& end, bool with_tail, RegionList& result)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	if (!find_touched (regions, start, end, with_tail)) {
+		return false;
+	}
+	collect (result);
+	return true;
+}
+
+bool
+RegionIndex::regions_touched (RegionList const& regions, timepos_t const& start, timepos_t const& end, bool with_tail, RegionVector& result)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	if (!find_touched (regions, start, end, with_tail)) {
+		return false;
+	}
+	collect (result);
+	return true;
+}
+
+bool
+RegionIndex::regions_with_start_within (RegionList const& regions, TimeRange const& range, RegionList& result)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (!prepare (regions)) {
+		return false;
+	}
+
+	int64_t const s = key (range.start ());
+	int64_t const e = key (range.end ());
+
+	auto i = std::lower_bound (_by_start.begin (), _by_start.end (), s, [] (Entry const& a, int64_t k) {
+		return a.start < k;
+	});
+
+	for (; i != _by_start.end () && i->start <= e; ++i) {
+		std::shared_ptr<Region> const& r (*i->region);
+		if (r->position () >= range.start () && r->position () < range.end ()) {
+			_hits.push_back (&(*i));
+		}
+	}
+
+	collect (result);
+	return true;
+}
+
+bool
+RegionIndex::regions_with_end_within (RegionList const& regions, TimeRange const& range, RegionList& result)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (!prepare (regions)) {
+		return false;
+	}
+
+	int64_t const s = key (range.start ());
+	int64_t const e = key (range.end ());
+
+	auto i = std::lower_bound (_by_last.begin (), _by_last.end (), s, [] (Entry const* a, int64_t k) {
+		return a->last < k;
+	});
+
+	for (; i != _by_last.end () && (*i)->last <= e; ++i) {
+		std::shared_ptr<Region> const& r (*(*i)->region);
+		if (r->nt_last () >= range.start () && r->nt_last () < range.end ()) {
+			_hits.push_back (*i);
+		}
+	}
+
+	collect (result);
+	return true;
+}
@@ -3658,6 +3658,34 @@ Route::all_outputs () const
 	return ios;
 }
 
+/** Estimate the time it takes to process this route, in microseconds.
+ * This uses measured plugin DSP load where available.
+ */
+double
+Route::graph_node_cost () const
+{
+	/* I/O, disk-reader, fader, meters etc. */
+	double cost = _disk_reader ? 2.0 : 1.0;
+
+	Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+
+	for (auto const& p : _processors) {
+		std::shared_ptr<PluginInsert> pi = std::dynamic_pointer_cast<PluginInsert> (p);
+		if (!pi || !pi->active ()) {
+			continue;
+		}
+		PBD::microseconds_t min, max;
+		double              avg, dev;
+		if (pi->get_stats (min, max, avg, dev)) {
+			cost += avg;
+		} else {
+			/* not yet measured, assume a lightweight plugin */
+			cost += 10.0 * pi->get_count ();
+		}
+	}
+	return cost;
+}
+
 bool
 Route::direct_feeds_according_to_reality (std::shared_ptr<GraphNode> node, bool* via_send_only)
 {
@@ -4097,7 +4125,7 @@ Route::roll (pframes_t nframes, samplepos_t start_sample, samplepos_t end_sample
 
 	run_route (start_sample, end_sample, nframes, (!_disk_writer || !_disk_writer->record_enabled()) && _session.transport_rolling(), true);
 
-	if ((_disk_reader && _disk_reader->need_butler()) || (_disk_writer && _disk_writer->need_butler())) {
+	if ((_disk_reader && _disk_reader->need_butler()) || (_disk_writer && _disk_writer->need_butler()) || (_triggerbox && _triggerbox->need_butler())) {
 		need_butler = true;
 	}
 	return 0;
@@ -134,7 +134,7 @@ RTMidiBufferBase<TimeType,DistanceType>::reverse ()
 				note_num = item->bytes[2];
 				channel = item->bytes[1] & 0xf;
 				if (previous_note_on[channel][note_num]) {
-					swap (item->bytes[1], previous_note_on[channel][note_num]->bytes[1]);
+					std::swap (item->bytes[1], previous_note_on[channel][note_num]->bytes[1]);
 					previous_note_on[channel][note_num] = 0;
 				} else {
 					std::cerr << "discovered note off without preceding note on... ignored\n";
@@ -171,7 +171,7 @@ RTMidiBufferBase<TimeType,DistanceType>::dump (uint32_t cnt)
 
 			/* more than 3 bytes ... indirect */
 
-			uint32_t offset = item->offset & ~(1<<(CHAR_BIT-1));
+			uint32_t offset = blob_offset (item->offset);
 			Blob* blob = reinterpret_cast<Blob*> (&_pool[offset]);
 
 			size = blob->size;
@@ -202,10 +202,13 @@ RTMidiBufferBase<TimeType,DistanceType>::write (TimeType time, Evoral::EventType
 	/* This buffer stores only MIDI, we don't care about the value of "type" */
 
 	if (_size + size >= _capacity) {
+		/* grow geometrically, rendering large regions one event at a
+		 * time must not copy the buffer for every 1024 events.
+		 */
 		if (size > 1024) {
-			resize (_capacity + size + 1024); // XXX 1024 is completely arbitrary
+			resize (std::max (_capacity * 2, _capacity + size + 1024)); // XXX 1024 is completely arbitrary
 		} else {
-			resize (_capacity + 1024); // XXX 1024 is completely arbitrary
+			resize (std::max (_capacity * 2, _capacity + 1024)); // XXX 1024 is completely arbitrary
 		}
 	}
 
@@ -215,8 +218,8 @@ RTMidiBufferBase<TimeType,DistanceType>::write (TimeType time, Evoral::EventType
 
 		uint32_t off = store_blob (size, buf);
 
-		/* non-zero MSbit indicates that the data (more than 3 bytes) is not inline */
-		_data[_size].offset = (off | (1<<(CHAR_BIT-1)));
+		/* non-zero bytes[0] indicates that the data (more than 3 bytes) is not inline */
+		_data[_size].offset = blob_ref (off);
 
 	} else {
 
@@ -243,6 +246,48 @@ RTMidiBufferBase<TimeType,DistanceType>::write (TimeType time, Evoral::EventType
 	return size;
 }
 
+template<class TimeType, class DistanceType>
+void
+RTMidiBufferBase<TimeType,DistanceType>::append (RTMidiBufferBase const& src, TimeType start, TimeType end)
+{
+	assert (!src._reversed);
+
+	Item const* const src_begin = src._data;
+	Item const* const src_end   = src._data + src._size;
+
+	Item const* first = std::lower_bound (src_begin, src_end, start,
+	                                      [] (Item const& item, TimeType const& t) { return item.timestamp < t; });
+	Item const* last  = std::lower_bound (first, src_end, end,
+	                                      [] (Item const& item, TimeType const& t) { return item.timestamp < t; });
+
+	if (first == last) {
+		return;
+	}
+
+	if (_size + (last - first) >= _capacity) {
+		resize (_size + (last - first) + 1024);
+	}
+
+	for (Item const* item = first; item != last; ++item) {
+		uint32_t       size;
+		uint8_t const* data = src.bytes (*item, size);
+		write (item->timestamp, Evoral::MIDI_EVENT, size, data);
+	}
+}
+
+template<class TimeType, class DistanceType>
+void
+RTMidiBufferBase<TimeType,DistanceType>::swap (RTMidiBufferBase& other)
+{
+	std::swap (_size, other._size);
+	std::swap (_capacity, other._capacity);
+	std::swap (_data, other._data);
+	std::swap (_reversed, other._reversed);
+	std::swap (_pool_size, other._pool_size);
+	std::swap (_pool_capacity, other._pool_capacity);
+	std::swap (_pool, other._pool);
+}
+
 /* requires C++20 to be usable */
 /*
 static
@@ -313,7 +358,7 @@ RTMidiBufferBase<TimeType,DistanceType>::track (MidiStateTracker& mst, TimeType
 
 			/* more than 3 bytes ... indirect */
 
-			uint32_t offset = item->offset & ~(1<<(CHAR_BIT-1));
+			uint32_t offset = blob_offset (item->offset);
 			Blob* blob = reinterpret_cast<Blob*> (&_pool[offset]);
 
 			addr = blob->data;
@@ -410,7 +455,7 @@ RTMidiBufferBase<TimeType,DistanceType>::read (MidiBuffer& dst, TimeType start,
 
 			/* more than 3 bytes ... indirect */
 
-			uint32_t offset = item->offset & ~(1<<(CHAR_BIT-1));
+			uint32_t offset = blob_offset (item->offset);
 			Blob* blob = reinterpret_cast<Blob*> (&_pool[offset]);
 
 			size = blob->size;
@@ -465,16 +510,15 @@ RTMidiBufferBase<TimeType,DistanceType>::alloc_blob (uint32_t size)
 		_pool_capacity += size * 4;
 
 		cache_aligned_malloc ((void **) &_pool, (_pool_capacity * sizeof (Blob)));
-		memcpy (_pool, old_pool, _pool_size * sizeof (Blob));
-		cache_aligned_free (old_pool);
+		if (old_pool) {
+			memcpy (_pool, old_pool, _pool_size * sizeof (Blob));
+			cache_aligned_free (old_pool);
+		}
 	}
 
 	uint32_t offset = _pool_size;
-#if defined(__arm__) || defined(__aarch64__)
-		_pool_size += ((size - 1) | 3) + 1;
-#else
-		_pool_size += size;
-#endif
+	/* keep the size of the next Blob aligned */
+	_pool_size += ((size - 1) | 3) + 1;
 
 	return offset;
 }
@@ -483,7 +527,8 @@ template<class TimeType, class DistanceType>
 uint32_t
 RTMidiBufferBase<TimeType,DistanceType>::store_blob (uint32_t size, uint8_t const * data)
 {
-	uint32_t offset = alloc_blob (size);
+	/* room for the size, followed by the data */
+	uint32_t offset = alloc_blob (sizeof (size) + size);
 	uint8_t* addr = &_pool[offset];
 
 	*(reinterpret_cast<uint32_t*> (addr)) = size;
@@ -68,6 +68,7 @@
 #include "ardour/audioengine.h"
 #include "ardour/audiofilesource.h"
 #include "ardour/auditioner.h"
+#include "ardour/automation_sidecar.h"
 #include "ardour/boost_debug.h"
 #include "ardour/buffer_manager.h"
 #include "ardour/buffer_set.h"
@@ -78,6 +79,7 @@
 #include "ardour/data_type.h"
 #include "ardour/debug.h"
 #include "ardour/disk_reader.h"
+#include "ardour/disk_writer.h"
 #include "ardour/directory_names.h"
 #include "ardour/filename_extensions.h"
 #include "ardour/gain_control.h"
@@ -340,6 +342,7 @@ Session::Session (AudioEngine &eng,
 	, have_looped (false)
 	, _step_editors (0)
 	,  _speakers (new Speakers)
+	, _graph_priorities_refreshed (0)
 	, _ignore_route_processor_changes (0)
 	, _ignored_a_processor_change (0)
 	, midi_clock (0)
@@ -2222,6 +2225,7 @@ Session::enable_record ()
 
 			_capture_duration = 0;
 			_capture_xruns = 0;
+			DiskWriter::reset_capture_margin ();
 
 			RecordStateChanged ();
 			break;
@@ -3181,6 +3185,9 @@ Session::new_route_from_template (uint32_t how_many, PresentationInfo::order_t i
 		return RouteList();
 	}
 
+	/* routes may be imported from another session's state file */
+	AutomationSidecar::inline_events (*tree.root (), Glib::build_filename (Glib::path_get_dirname (template_path), automation_dir_name));
+
 	return new_route_from_template (how_many, insert_at, *tree.root(), name_base, pd);
 }
 
@@ -6681,6 +6688,52 @@ Session::plot_process_graph (std::string const& file_name) const {
 	return _graph_chain ? _graph_chain->plot (file_name) : false;
 }
 
+void
+Session::refresh_process_graph_priorities ()
+{
+	int64_t const now = g_get_monotonic_time ();
+	if (now - _graph_priorities_refreshed < 1000000) {
+		return;
+	}
+	_graph_priorities_refreshed = now;
+
+	std::shared_ptr<GraphChain> graph_chain = _graph_chain;
+	if (graph_chain) {
+		graph_chain->refresh_priorities ();
+	}
+}
+
+/** Start recording per route/IOPlug timing of the process graph.
+ * collect_process_graph_timing() needs to be called periodically
+ * to retrieve data from the realtime threads.
+ */
+void
+Session::start_process_graph_timing ()
+{
+	_process_graph->start_node_timing ();
+}
+
+void
+Session::stop_process_graph_timing ()
+{
+	_process_graph->stop_node_timing ();
+}
+
+size_t
+Session::collect_process_graph_timing ()
+{
+	return _process_graph->drain_node_timing ();
+}
+
+/** Write process graph timing collected since the last call to
+ * start_process_graph_timing() as Chrome trace-event JSON.
+ */
+bool
+Session::write_process_graph_timing (std::string const& file_name)
+{
+	return _process_graph->write_node_timing (file_name);
+}
+
 void
 Session::add_automation_list(AutomationList *al)
 {
@@ -35,6 +35,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <cerrno>
 #include <cstdio> /* snprintf(3) ... grrr */
@@ -86,6 +87,7 @@
 #include "pbd/pthread_utils.h"
 #include "pbd/progress.h"
 #include "pbd/scoped_file_descriptor.h"
+#include "pbd/timing.h"
 #include "pbd/types_convert.h"
 #include "pbd/localtime_r.h"
 #include "pbd/unwind.h"
@@ -98,6 +100,7 @@
 #include "ardour/audioregion.h"
 #include "ardour/auditioner.h"
 #include "ardour/automation_control.h"
+#include "ardour/automation_sidecar.h"
 #include "ardour/boost_debug.h"
 #include "ardour/butler.h"
 #include "ardour/control_protocol_manager.h"
@@ -842,6 +845,12 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		mark_as_clean = false;
 		tree.set_root (&get_template());
 	} else {
+		/* only the session file references sidecar files, archives
+		 * and undo history (saved below) must be self-contained.
+		 */
+		std::string const sidecar_dir = automation_dir ();
+		AutomationSidecar::Saving sidecar (Config->get_save_automation_sidecar () && !for_archive, sidecar_dir);
+
 		tree.set_root (&state (false, fork_state, for_archive, only_used_assets));
 	}
 
@@ -1709,6 +1718,7 @@ Session::set_state (const XMLNode& node, int version)
 	XMLNodeList nlist;
 	XMLNode* child;
 	int ret = -1;
+	PBD::Timing load_timing;
 
 	_state_of_the_state = StateOfTheState (_state_of_the_state | CannotSave);
 
@@ -1719,6 +1729,9 @@ Session::set_state (const XMLNode& node, int version)
 
 	node.get_property ("name", _name);
 
+	/* automation lists may reference events stored in binary files */
+	AutomationSidecar::set_directory (automation_dir ());
+
 	if (node.get_property (X_("sample-rate"), _base_sample_rate)) {
 
 		bool reconfigured = false;
@@ -1873,6 +1886,8 @@ Session::set_state (const XMLNode& node, int version)
 		_speakers->set_state (*child, version);
 	}
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("session setup: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	if ((child = find_named_node (node, "Sources")) == 0) {
 		error << _("Session: XML state has no 'Sources' section") << endmsg;
 		goto out;
@@ -1881,6 +1896,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("sources: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	if ((child = find_named_node (node, "Locations")) == 0) {
 		error << _("Session: XML state has no 'Locations' section") << endmsg;
 		goto out;
@@ -1903,6 +1920,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("locations and regions: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	if ((child = find_named_node (node, "Playlists")) == 0) {
 		error << _("Session: XML state has no 'Playlists' section") << endmsg;
 		goto out;
@@ -1925,6 +1944,8 @@ Session::set_state (const XMLNode& node, int version)
 		}
 	}
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("playlists: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	if (version >= 3000) {
 		if ((child = find_named_node (node, "Bundles")) == 0) {
 			warning << _("Session: XML state has no 'Bundles' section") << endmsg;
@@ -2004,6 +2025,8 @@ Session::set_state (const XMLNode& node, int version)
 		}
 	}
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("bundles, VCAs and whole-file regions: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	if ((child = find_named_node (node, "Routes")) == 0) {
 		error << _("Session: XML state has no 'Routes' section") << endmsg;
 		goto out;
@@ -2012,6 +2035,8 @@ Session::set_state (const XMLNode& node, int version)
 		goto out;
 	}
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("routes: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	/* Now that we Tracks have been loaded and playlists are assigned */
 	_playlists->update_tracking ();
 
@@ -2117,6 +2142,8 @@ Session::set_state (const XMLNode& node, int version)
 	update_route_record_state ();
 	sync_cues ();
 
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("groups, scripts, scenes, I/O plugins: %1 ms\n", load_timing.get_interval () / 1000.));
+
 	/* here beginneth the second phase ... */
 	set_snapshot_name (_current_snapshot_name);
 
@@ -2723,6 +2750,8 @@ Session::load_sources (const XMLNode& node)
 	set_dirty();
 	std::map<std::string, std::string> relocation;
 
+	prefetch_sources (node);
+
 	for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
 #ifdef PLATFORM_WINDOWS
 		int old_mode = 0;
@@ -2769,6 +2798,7 @@ retry:
 			if (err.type == DataType::MIDI && Glib::path_is_absolute (err.path)) {
 				error << string_compose (_("An external MIDI file is missing. %1 cannot currently recover from missing external MIDI files"),
 						PROGRAM_NAME) << endmsg;
+				SndFileSource::drop_prefetched ();
 				return -1;
 			}
 
@@ -2798,6 +2828,7 @@ retry:
 
 				case 1:
 					/* user asked to quit the entire session load */
+					SndFileSource::drop_prefetched ();
 					return -1;
 
 				case 2:
@@ -2829,6 +2860,7 @@ retry:
 								/* this should be an unrecoverable error: we would be creating a MIDI file outside
 								 * the session tree.
 								 */
+								SndFileSource::drop_prefetched ();
 								return -1;
 							}
 							/* Note that we do not announce the source just yet - we need to reset its ID before we do that */
@@ -2844,9 +2876,91 @@ retry:
 		}
 	}
 
+	SndFileSource::drop_prefetched ();
 	return 0;
 }
 
+void
+Session::prefetch_sources (const XMLNode& node)
+{
+	/* With large sessions most of the time to create sources is spent
+	 * waiting for the disk, locating and opening files and parsing their
+	 * headers. Do that for all audio files in parallel first. The sources
+	 * (which have to be created one at a time, since this may involve
+	 * asking the user about missing files) then take over the open files.
+	 */
+	std::vector<std::string> const dirs = source_search_path (DataType::AUDIO);
+	std::vector<std::vector<std::string> > candidates;
+
+	for (auto const& n : node.children ()) {
+		if (n->name () != X_("Source")) {
+			continue;
+		}
+
+		DataType    type (DataType::AUDIO);
+		std::string name;
+		std::string origin;
+
+		if (!n->get_property (X_("name"), name) || (n->get_property (X_("type"), type) && type != DataType::AUDIO)) {
+			continue;
+		}
+
+		std::vector<std::string> paths;
+
+		if (n->get_property (X_("origin"), origin) && Glib::path_is_absolute (origin)) {
+			paths.push_back (origin);
+		} else if (Glib::path_is_absolute (name)) {
+			paths.push_back (name);
+		} else {
+			for (auto const& d : dirs) {
+				paths.push_back (Glib::build_filename (d, name));
+			}
+		}
+
+		candidates.push_back (paths);
+	}
+
+	if (candidates.size () < 2) {
+		return;
+	}
+
+	PBD::Timing t;
+
+	/* This runs in the GUI thread, not the butler, so use a set of plain
+	 * (non-realtime) threads instead of the session's I/O threads.
+	 */
+	std::atomic<size_t> next (0);
+
+	auto work = [&candidates, &next] () {
+		for (size_t i = next.fetch_add (1); i < candidates.size (); i = next.fetch_add (1)) {
+			for (auto const& p : candidates[i]) {
+				if (SndFileSource::prefetch (p)) {
+					break;
+				}
+			}
+		}
+	};
+
+	uint32_t const n_threads = std::min<size_t> (how_many_io_threads (), candidates.size ());
+
+	std::vector<PBD::Thread*> pool;
+	for (uint32_t n = 1; n < n_threads; ++n) {
+		PBD::Thread* thread = PBD::Thread::create (work, string_compose ("SourcePrefetch-%1", n));
+		if (thread) {
+			pool.push_back (thread);
+		}
+	}
+
+	work ();
+
+	for (auto& thread : pool) {
+		thread->join ();
+		delete thread;
+	}
+
+	DEBUG_TRACE (DEBUG::SessionLoad, string_compose ("prefetched %1 sources: %2 ms\n", candidates.size (), t.get_interval () / 1000.));
+}
+
 std::shared_ptr<Source>
 Session::XMLSourceFactory (const XMLNode& node)
 {
@@ -3578,8 +3692,11 @@ Session::cleanup_peakfiles ()
 
 	_state_of_the_state = StateOfTheState (_state_of_the_state | PeakCleanup);
 
+	/* all sources are queued again below */
+	SourceFactory::cancel_peak_building ();
+
 	int timeout = 5000; // 5 seconds
-	while (!SourceFactory::files_with_peaks.empty()) {
+	while (SourceFactory::peak_work_queue_length () > 0) {
 		Glib::usleep (1000);
 		if (--timeout < 0) {
 			warning << _("Timeout waiting for peak-file creation to terminate before cleanup, please try again later.") << endmsg;
@@ -1326,6 +1326,7 @@ Session::non_realtime_locate ()
 	   non-realtime locates.
 	*/
 	_butler_seek_counter.store (sc);
+	_butler->note_locate (tf);
 
 	{
 		/* VCAs are quick to locate because they have no data (except
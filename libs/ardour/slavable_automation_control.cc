@@ -133,9 +133,7 @@ SlavableAutomationControl::masters_curve_multiply (timepos_t const & start, time
 	bool from_list = _list && std::dynamic_pointer_cast<AutomationList>(_list)->automation_playback();
 	bool rv = from_list && list()->curve().rt_safe_get_vector (start, end, scratch, veclen);
 	if (rv) {
-		for (samplecnt_t i = 0; i < veclen; ++i) {
-			vec[i] *= scratch[i];
-		}
+		apply_gain_vector_to_buffer (vec, scratch, veclen);
 	} else {
 		apply_gain_to_buffer (vec, veclen, Control::get_double ());
 	}
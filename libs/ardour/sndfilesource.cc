@@ -31,6 +31,8 @@
 #include <climits>
 #include <cstdarg>
 #include <fcntl.h>
+#include <map>
+#include <vector>
 
 #include <sys/stat.h>
 
@@ -48,6 +50,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -61,6 +64,22 @@ using namespace ARDOUR;
 using namespace PBD;
 using std::string;
 
+struct SndFileSource::SharedReadCache {
+	SharedReadCache (uint32_t nchn)
+		: n_channels (nchn)
+		, start (0)
+		, cnt (0)
+		, capacity (0)
+	{}
+
+	Glib::Threads::Mutex lock;
+	uint32_t             n_channels;
+	samplepos_t          start;
+	samplecnt_t          cnt;
+	samplecnt_t          capacity; // per channel
+	std::vector<Sample>  planes;   // n_channels * capacity
+};
+
 const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::Writable |
 		Source::Removable |
@@ -340,6 +359,16 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd              = -1;
+	_data_offset     = 0;
+	_bytes_per_frame = 0;
+	_last_read_end   = -1;
+	_write_fd        = -1;
+	_write_allocated = -1;
+	_write_started   = 0;
+	_write_done      = 0;
+	_write_bounded   = false;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, std::bind (&SndFileSource::handle_header_position_change, this));
 }
 
@@ -347,12 +376,294 @@ void
 SndFileSource::close ()
 {
 	if (_sndfile) {
+		finish_write_behind ();
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
+		_write_fd = -1;
+		_bytes_per_frame = 0;
+		_read_cache.reset ();
 		file_closed ();
 	}
 }
 
+void
+SndFileSource::attach_read_cache ()
+{
+	if (writable () || _info.channels < 2) {
+		return;
+	}
+
+	/* one cache per file, shared by all sources that have it open */
+	static Glib::Threads::Mutex                                    read_cache_lock;
+	static std::map<std::string, std::weak_ptr<SharedReadCache>> read_caches;
+
+	Glib::Threads::Mutex::Lock lm (read_cache_lock);
+
+	std::shared_ptr<SharedReadCache> c (read_caches[_path].lock ());
+	if (!c || c->n_channels != (uint32_t) _info.channels) {
+		c.reset (new SharedReadCache (_info.channels));
+		read_caches[_path] = c;
+	}
+	_read_cache = c;
+
+	/* remove caches of files that are no longer open */
+	for (auto i = read_caches.begin (); i != read_caches.end ();) {
+		if (i->second.expired ()) {
+			i = read_caches.erase (i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void
+SndFileSource::setup_read_ahead (int fd)
+{
+	_bytes_per_frame = 0;
+	_last_read_end   = -1;
+
+#ifdef POSIX_FADV_WILLNEED
+	if (writable ()) {
+		return;
+	}
+
+	switch (_info.format & SF_FORMAT_TYPEMASK) {
+		case SF_FORMAT_WAV:
+		case SF_FORMAT_WAVEX:
+		case SF_FORMAT_RF64:
+		case SF_FORMAT_W64:
+		case SF_FORMAT_AIFF:
+		case SF_FORMAT_CAF:
+		case SF_FORMAT_AU:
+		case SF_FORMAT_RAW:
+			break;
+		default:
+			/* FLAC, Ogg etc. also use PCM subtypes, but their data is not laid out linearly */
+			return;
+	}
+
+	uint32_t bytes_per_sample;
+
+	switch (_info.format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_PCM_S8:
+		case SF_FORMAT_PCM_U8:
+			bytes_per_sample = 1;
+			break;
+		case SF_FORMAT_PCM_16:
+			bytes_per_sample = 2;
+			break;
+		case SF_FORMAT_PCM_24:
+			bytes_per_sample = 3;
+			break;
+		case SF_FORMAT_PCM_32:
+		case SF_FORMAT_FLOAT:
+			bytes_per_sample = 4;
+			break;
+		case SF_FORMAT_DOUBLE:
+			bytes_per_sample = 8;
+			break;
+		default:
+			/* compressed, file offsets are not known */
+			return;
+	}
+
+	/* after opening a file, libsndfile leaves it positioned at the start of the audio data */
+	off_t const pos = lseek (fd, 0, SEEK_CUR);
+	if (pos < 0) {
+		return;
+	}
+
+	_fd              = fd;
+	_data_offset     = pos;
+	_bytes_per_frame = bytes_per_sample * _info.channels;
+#endif
+}
+
+void
+SndFileSource::read_ahead (samplepos_t start, samplecnt_t cnt) const
+{
+	/* When a file is read sequentially (by the butler), ask the kernel
+	 * to fetch the next chunk asynchronously. Since this happens for
+	 * every source during a butler pass, reads for all tracks are queued
+	 * at once, rather than one blocking read at a time.
+	 */
+	bool const sequential = start == _last_read_end;
+	_last_read_end = start + cnt;
+
+#ifdef POSIX_FADV_WILLNEED
+	if (!sequential || _bytes_per_frame == 0 || _fd < 0 || start + cnt >= _length.samples ()) {
+		return;
+	}
+	samplecnt_t const n = std::min (cnt, _length.samples () - start - cnt);
+	posix_fadvise (_fd, _data_offset + (off_t) (start + cnt) * _bytes_per_frame, (off_t) n * _bytes_per_frame, POSIX_FADV_WILLNEED);
+#else
+	(void) sequential;
+#endif
+}
+
+/* space for capture files is reserved in chunks of this size */
+static const off_t write_behind_extent = 64 * 1048576;
+/* data is written back in chunks of this size, at most two of them are cached per file */
+static const off_t write_behind_window = 4 * 1048576;
+
+void
+SndFileSource::setup_write_behind (int fd)
+{
+	_write_fd        = -1;
+	_write_allocated = -1;
+	_write_bounded   = false;
+
+#ifdef __linux__
+	if (!writable ()) {
+		return;
+	}
+
+	off_t const pos = lseek (fd, 0, SEEK_CUR);
+	if (pos < 0) {
+		return;
+	}
+
+	_write_fd        = fd;
+	_write_started   = pos;
+	_write_done      = pos;
+	_write_bounded   = Config->get_capture_write_behind ();
+	_write_allocated = _write_bounded ? pos : -1;
+#endif
+}
+
+void
+SndFileSource::write_behind ()
+{
+	/* Capture files grow continuously, and with many tracks armed the
+	 * kernel may both fragment the files and accumulate a lot of dirty
+	 * pages, which are then written out in large, stalling bursts.
+	 *
+	 * Start writing back each chunk as soon as it is complete, without
+	 * waiting for it. During a butler pass this submits the data of all
+	 * tracks to the device together, like read_ahead() does for reads.
+	 *
+	 * With capture-write-behind, also reserve space ahead of the data
+	 * (without changing the file size, so the header remains valid),
+	 * and drop each chunk from the page cache once it is on disk.
+	 */
+#ifdef __linux__
+	if (_write_fd < 0) {
+		return;
+	}
+
+	off_t const pos = lseek (_write_fd, 0, SEEK_CUR);
+	if (pos < 0) {
+		return;
+	}
+
+	if (_write_allocated >= 0 && pos + write_behind_extent / 2 > _write_allocated) {
+		off_t const start = std::max (pos, _write_allocated);
+		if (fallocate (_write_fd, FALLOC_FL_KEEP_SIZE, start, write_behind_extent) == 0) {
+			_write_allocated = start + write_behind_extent;
+		} else {
+			/* not supported by the file-system */
+			_write_allocated = -1;
+		}
+	}
+
+	if (pos - _write_started >= write_behind_window) {
+		if (_write_bounded && _write_started > _write_done) {
+			sync_file_range (_write_fd, _write_done, _write_started - _write_done, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+			posix_fadvise (_write_fd, _write_done, _write_started - _write_done, POSIX_FADV_DONTNEED);
+			_write_done = _write_started;
+		}
+		sync_file_range (_write_fd, _write_started, pos - _write_started, SYNC_FILE_RANGE_WRITE);
+		_write_started = pos;
+	}
+#endif
+}
+
+void
+SndFileSource::finish_write_behind ()
+{
+#ifdef __linux__
+	if (_write_fd < 0) {
+		return;
+	}
+
+	struct stat st;
+
+	if (_write_allocated >= 0 && fstat (_write_fd, &st) == 0 && st.st_size < _write_allocated) {
+		/* release space that was reserved but not used */
+		fallocate (_write_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, st.st_size, _write_allocated - st.st_size);
+		_write_allocated = st.st_size;
+	}
+
+	/* start writing back the remaining data */
+	sync_file_range (_write_fd, _write_done, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+}
+
+Glib::Threads::Mutex                                  SndFileSource::_prefetch_lock;
+std::multimap<std::string, SndFileSource::Prefetched> SndFileSource::_prefetched;
+
+bool
+SndFileSource::prefetch (const string& path)
+{
+	if (!Glib::file_test (path, Glib::FILE_TEST_IS_REGULAR)) {
+		return false;
+	}
+
+#ifdef PLATFORM_WINDOWS
+	int fd = g_open (path.c_str(), O_RDONLY, 0444);
+#else
+	int fd = ::open (path.c_str(), O_RDONLY, 0444);
+#endif
+
+	if (fd == -1) {
+		return false;
+	}
+
+	Prefetched p;
+	p.fd = fd;
+	p.info.format = 0; // libsndfile says to clear this before sf_open_fd
+	p.sndfile = sf_open_fd (fd, SFM_READ, &p.info, true);
+
+	if (!p.sndfile) {
+		return false;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_prefetch_lock);
+	_prefetched.insert (make_pair (path, p));
+	return true;
+}
+
+void
+SndFileSource::drop_prefetched ()
+{
+	Glib::Threads::Mutex::Lock lm (_prefetch_lock);
+	for (auto& p : _prefetched) {
+		sf_close (p.second.sndfile);
+	}
+	_prefetched.clear ();
+}
+
+bool
+SndFileSource::take_prefetched (int& fd)
+{
+	if (writable ()) {
+		return false;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_prefetch_lock);
+	auto i = _prefetched.find (_path);
+	if (i == _prefetched.end ()) {
+		return false;
+	}
+
+	fd       = i->second.fd;
+	_sndfile = i->second.sndfile;
+	_info    = i->second.info;
+	_prefetched.erase (i);
+	return true;
+}
+
 int
 SndFileSource::open ()
 {
@@ -360,33 +671,39 @@ SndFileSource::open ()
 		return 0;
 	}
 
-// We really only want to use g_open for all platforms but because of this
-// method(SndfileSource::open), the compiler(or at least GCC) is confused
-// because g_open will expand to "open" on non-POSIX systems and needs the
-// global namespace qualifier. The problem is since since C99 ::g_open will
-// apparently expand to ":: open"
+	int fd;
+
+	if (take_prefetched (fd)) {
+		/* opened and parsed by prefetch () */
+	} else {
+		// We really only want to use g_open for all platforms but because of this
+		// method(SndfileSource::open), the compiler(or at least GCC) is confused
+		// because g_open will expand to "open" on non-POSIX systems and needs the
+		// global namespace qualifier. The problem is since since C99 ::g_open will
+		// apparently expand to ":: open"
 #ifdef PLATFORM_WINDOWS
-	int fd = g_open (_path.c_str(), writable() ? O_CREAT | O_RDWR : O_RDONLY, writable() ? 0644 : 0444);
+		fd = g_open (_path.c_str(), writable() ? O_CREAT | O_RDWR : O_RDONLY, writable() ? 0644 : 0444);
 #else
-	int fd = ::open (_path.c_str(), writable() ? O_CREAT | O_RDWR : O_RDONLY, writable() ? 0644 : 0444);
+		fd = ::open (_path.c_str(), writable() ? O_CREAT | O_RDWR : O_RDONLY, writable() ? 0644 : 0444);
 #endif
 
-	if (fd == -1) {
-		error << string_compose (
-		             _ ("SndFileSource: cannot open file \"%1\" for %2"),
-		             _path,
-		             (writable () ? "read+write" : "reading")) << endmsg;
-		return -1;
-	}
+		if (fd == -1) {
+			error << string_compose (
+			             _ ("SndFileSource: cannot open file \"%1\" for %2"),
+			             _path,
+			             (writable () ? "read+write" : "reading")) << endmsg;
+			return -1;
+		}
 
-	if ((_info.format & SF_FORMAT_TYPEMASK ) == SF_FORMAT_FLAC) {
-		_sndfile = sf_open_fd (fd, writable () ? SFM_WRITE : SFM_READ, &_info, true);
-	} else {
-		_sndfile = sf_open_fd (fd, writable() ? SFM_RDWR : SFM_READ, &_info, true);
-	}
+		if ((_info.format & SF_FORMAT_TYPEMASK ) == SF_FORMAT_FLAC) {
+			_sndfile = sf_open_fd (fd, writable () ? SFM_WRITE : SFM_READ, &_info, true);
+		} else {
+			_sndfile = sf_open_fd (fd, writable() ? SFM_RDWR : SFM_READ, &_info, true);
+		}
 
-	if (_sndfile == 0) {
-		return -1;
+		if (_sndfile == 0) {
+			return -1;
+		}
 	}
 
 	if (_channel >= _info.channels) {
@@ -401,6 +718,10 @@ SndFileSource::open ()
 
 	_length = timecnt_t (_info.frames);
 
+	attach_read_cache ();
+	setup_read_ahead (fd);
+	setup_write_behind (fd);
+
 #ifdef HAVE_RF64_RIFF
 	if (_file_is_new && _length == 0 && writable()) {
 		if (_flags & RF64_RIFF) {
@@ -548,6 +869,11 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt && _read_cache && _read_cache.use_count () > 1) {
+		/* other channels of the same file are in use, too */
+		return read_cached (dst, start, file_cnt);
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -559,6 +885,7 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 
 		if (_info.channels == 1) {
 			samplecnt_t ret = sf_read_float (_sndfile, dst, file_cnt);
+			read_ahead (start, ret);
 			if (ret != file_cnt) {
 				char errbuf[256];
 				sf_error_str (0, errbuf, sizeof (errbuf) - 1);
@@ -581,6 +908,8 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	ptr = interleave_buf + _channel;
 	nread /= _info.channels;
 
+	read_ahead (start, nread);
+
 	/* stride through the interleaved data */
 
 	if (_gain != 1.f) {
@@ -598,6 +927,65 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	return nread;
 }
 
+samplecnt_t
+SndFileSource::read_cached (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	SharedReadCache& c (*_read_cache);
+	Glib::Threads::Mutex::Lock lm (c.lock);
+
+	if (start < c.start || start + cnt > c.start + c.cnt) {
+
+		/* Read and deinterleave all channels at once. Sibling sources are
+		 * usually read by the butler for the same position and amount.
+		 */
+
+		samplepos_t const prev_end = c.start + c.cnt;
+
+		c.cnt = 0;
+
+		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
+			char errbuf[256];
+			sf_error_str (0, errbuf, sizeof (errbuf) - 1);
+			error << string_compose(_("SndFileSource: could not seek to sample %1 within %2 (%3)"), start, _name, errbuf) << endmsg;
+			return 0;
+		}
+
+		Sample*     interleave_buf = get_interleave_buffer (cnt * c.n_channels);
+		samplecnt_t nread          = sf_readf_float (_sndfile, interleave_buf, cnt);
+
+		if (nread < 0) {
+			nread = 0;
+		}
+
+		if (c.capacity < cnt) {
+			c.capacity = cnt;
+			c.planes.resize (c.n_channels * c.capacity);
+		}
+
+		for (uint32_t chn = 0; chn < c.n_channels; ++chn) {
+			deinterleave_channel (&c.planes[chn * c.capacity], interleave_buf, nread, chn, c.n_channels);
+		}
+
+		c.start = start;
+		c.cnt   = nread;
+
+		/* siblings take turns reading the file */
+		_last_read_end = prev_end;
+		read_ahead (start, nread);
+	}
+
+	samplecnt_t const n = std::min (cnt, c.start + c.cnt - start);
+
+	if (n > 0) {
+		memcpy (dst, &c.planes[_channel * c.capacity + (start - c.start)], n * sizeof (Sample));
+		if (_gain != 1.f) {
+			apply_gain_to_buffer (dst, n, _gain);
+		}
+	}
+
+	return std::max<samplecnt_t> (0, n);
+}
+
 samplecnt_t
 SndFileSource::write_unlocked (Sample const * data, samplecnt_t cnt)
 {
@@ -629,6 +1017,8 @@ SndFileSource::nondestructive_write_unlocked (Sample const * data, samplecnt_t c
 		return 0;
 	}
 
+	write_behind ();
+
 	assert (_length.time_domain() == Temporal::AudioTime);
 	update_length (timepos_t (_length.samples() + cnt));
 
@@ -668,6 +1058,8 @@ SndFileSource::flush_header ()
 
 	int const r = sf_command (_sndfile, SFC_UPDATE_HEADER_NOW, 0, 0) != SF_TRUE;
 
+	finish_write_behind ();
+
 	return r;
 }
 
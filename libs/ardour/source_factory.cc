@@ -24,7 +24,10 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
+
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 
 #include "temporal/tempo.h"
@@ -58,9 +61,13 @@ Glib::Threads::Mutex                          SourceFactory::peak_building_lock;
 std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peaks;
 std::vector<PBD::Thread*>                     SourceFactory::peak_thread_pool;
 bool                                          SourceFactory::peak_thread_run = false;
+size_t                                        SourceFactory::n_prioritized_peakfiles = 0;
 
 static int active_threads = 0;
 
+/* sources that are currently being processed by a peak_thread_work() thread */
+static std::vector<std::shared_ptr<AudioSource>> active_sources;
+
 static void
 peak_thread_work ()
 {
@@ -85,8 +92,13 @@ peak_thread_work ()
 
 		std::shared_ptr<AudioSource> as (SourceFactory::files_with_peaks.front ().lock ());
 		SourceFactory::files_with_peaks.pop_front ();
+		if (SourceFactory::n_prioritized_peakfiles > 0) {
+			--SourceFactory::n_prioritized_peakfiles;
+		}
 		if (as) {
 			++active_threads;
+			as->set_peak_building_cancelled (false);
+			active_sources.push_back (as);
 		}
 		SourceFactory::peak_building_lock.unlock ();
 
@@ -94,9 +106,12 @@ peak_thread_work ()
 			continue;
 		}
 
+		/* each thread reads a single file sequentially, from start to end */
 		as->setup_peakfile ();
+
 		SourceFactory::peak_building_lock.lock ();
 		--active_threads;
+		active_sources.erase (std::find (active_sources.begin (), active_sources.end (), as));
 		SourceFactory::peak_building_lock.unlock ();
 	}
 }
@@ -109,6 +124,55 @@ SourceFactory::peak_work_queue_length ()
 	return SourceFactory::files_with_peaks.size () + active_threads;
 }
 
+void
+SourceFactory::prioritize_peakfiles (std::vector<std::shared_ptr<AudioSource>> const& sources)
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+
+	if (files_with_peaks.empty ()) {
+		return;
+	}
+
+	/* Move queued sources to the end of the prioritized range at the front of the
+	 * queue. Sources that are already prioritized keep their position, so that
+	 * repeated calls (e.g. while scrolling) do not re-order the visible set.
+	 */
+	std::list<std::weak_ptr<AudioSource>>::iterator insert_at = files_with_peaks.begin ();
+	std::advance (insert_at, std::min<size_t> (n_prioritized_peakfiles, files_with_peaks.size ()));
+
+	for (std::list<std::weak_ptr<AudioSource>>::iterator i = insert_at; i != files_with_peaks.end ();) {
+		std::shared_ptr<AudioSource> as (i->lock ());
+		if (!as || std::find (sources.begin (), sources.end (), as) == sources.end ()) {
+			++i;
+			continue;
+		}
+		std::list<std::weak_ptr<AudioSource>>::iterator next = i;
+		++next;
+		if (i == insert_at) {
+			++insert_at;
+		} else {
+			files_with_peaks.splice (insert_at, files_with_peaks, i);
+		}
+		++n_prioritized_peakfiles;
+		i = next;
+	}
+}
+
+void
+SourceFactory::cancel_peak_building ()
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+
+	files_with_peaks.clear ();
+	n_prioritized_peakfiles = 0;
+
+	/* builds in progress stop after the current chunk,
+	 * and remove the incomplete peakfile */
+	for (auto const& as : active_sources) {
+		as->set_peak_building_cancelled (true);
+	}
+}
+
 void
 SourceFactory::init ()
 {
@@ -116,7 +180,14 @@ SourceFactory::init ()
 		return;
 	}
 	peak_thread_run = true;
-	for (int n = 0; n < 2; ++n) {
+
+	/* Peak building is mostly I/O bound. Using a few threads helps with
+	 * many small files and on SSDs, while more than that would only
+	 * cause seeks on spinning disks.
+	 */
+	uint32_t const n_threads = std::max<uint32_t> (2, std::min<uint32_t> (4, hardware_concurrency () / 2));
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
 		peak_thread_pool.push_back (PBD::Thread::create (&peak_thread_work, string_compose ("PeakFileBuilder-%1", n)));
 	}
 }
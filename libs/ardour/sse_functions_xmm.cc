@@ -116,3 +116,123 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 
 
 
+
+void
+x86_sse_apply_gain_vector_to_buffer (float* buf, const float* gain, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		_mm_storeu_ps (buf, _mm_mul_ps (_mm_loadu_ps (buf), _mm_loadu_ps (gain)));
+		buf += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+	while (nframes > 0) {
+		*buf++ *= *gain++;
+		--nframes;
+	}
+}
+
+void
+x86_sse_mix_buffers_with_gain_vector (float* dst, const float* src, const float* gain, uint32_t nframes)
+{
+	while (nframes >= 4) {
+		__m128 x = _mm_mul_ps (_mm_loadu_ps (src), _mm_loadu_ps (gain));
+		_mm_storeu_ps (dst, _mm_add_ps (_mm_loadu_ps (dst), x));
+		dst += 4;
+		src += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+}
+
+float
+x86_sse_sum_of_squares (const float* buf, uint32_t nframes)
+{
+	__m128 acc0 = _mm_setzero_ps ();
+	__m128 acc1 = _mm_setzero_ps ();
+
+	while (nframes >= 8) {
+		__m128 x0 = _mm_loadu_ps (buf);
+		__m128 x1 = _mm_loadu_ps (buf + 4);
+		acc0 = _mm_add_ps (acc0, _mm_mul_ps (x0, x0));
+		acc1 = _mm_add_ps (acc1, _mm_mul_ps (x1, x1));
+		buf += 8;
+		nframes -= 8;
+	}
+
+	acc0 = _mm_add_ps (acc0, acc1);
+	acc0 = _mm_add_ps (acc0, _mm_movehl_ps (acc0, acc0));
+	acc0 = _mm_add_ss (acc0, _mm_shuffle_ps (acc0, acc0, _MM_SHUFFLE (1, 1, 1, 1)));
+
+	float sum;
+	_mm_store_ss (&sum, acc0);
+
+	while (nframes > 0) {
+		sum += *buf * *buf;
+		++buf;
+		--nframes;
+	}
+	return sum;
+}
+
+void
+x86_sse_interleave_channel (float* dst, const float* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 2) {
+		/* stereo: merge with the other channel, 4 frames at a time */
+		while (nframes >= 4) {
+			__m128 x  = _mm_loadu_ps (src);
+			__m128 d0 = _mm_loadu_ps (dst);
+			__m128 d1 = _mm_loadu_ps (dst + 4);
+			if (channel == 0) {
+				__m128 r = _mm_shuffle_ps (d0, d1, _MM_SHUFFLE (3, 1, 3, 1));
+				_mm_storeu_ps (dst,     _mm_unpacklo_ps (x, r));
+				_mm_storeu_ps (dst + 4, _mm_unpackhi_ps (x, r));
+			} else {
+				__m128 l = _mm_shuffle_ps (d0, d1, _MM_SHUFFLE (2, 0, 2, 0));
+				_mm_storeu_ps (dst,     _mm_unpacklo_ps (l, x));
+				_mm_storeu_ps (dst + 4, _mm_unpackhi_ps (l, x));
+			}
+			src += 4;
+			dst += 8;
+			nframes -= 4;
+		}
+	}
+
+	dst += channel;
+	while (nframes > 0) {
+		*dst = *src++;
+		dst += n_channels;
+		--nframes;
+	}
+}
+
+void
+x86_sse_deinterleave_channel (float* dst, const float* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 2) {
+		while (nframes >= 4) {
+			__m128 s0 = _mm_loadu_ps (src);
+			__m128 s1 = _mm_loadu_ps (src + 4);
+			if (channel == 0) {
+				_mm_storeu_ps (dst, _mm_shuffle_ps (s0, s1, _MM_SHUFFLE (2, 0, 2, 0)));
+			} else {
+				_mm_storeu_ps (dst, _mm_shuffle_ps (s0, s1, _MM_SHUFFLE (3, 1, 3, 1)));
+			}
+			src += 8;
+			dst += 4;
+			nframes -= 4;
+		}
+	}
+
+	src += channel;
+	while (nframes > 0) {
+		*dst++ = *src;
+		src += n_channels;
+		--nframes;
+	}
+}
@@ -24,6 +24,7 @@
 #include "pbd/properties.h"
 #include "pbd/stateful_diff_command.h"
 #include "ardour/automation_list.h"
+#include "ardour/automation_sidecar.h"
 #include "automation_list_property_test.h"
 #include "test_util.h"
 
@@ -180,3 +181,110 @@ AutomationListPropertyTest::undoTest ()
 	write_automation_list_xml (&sheila->get_state(), test_data_filename);
 	check_xml (&sheila->get_state(), test_data_file4, ignore_properties);
 }
+
+static std::string
+serialized_events (AutomationList const& al)
+{
+	XMLNode&       state  = al.get_state ();
+	XMLNode const* events = state.child (X_("events"));
+	std::string    rv     = events ? events->children ().front ()->content () : "";
+	delete &state;
+	return rv;
+}
+
+void
+AutomationListPropertyTest::cachedStateTest ()
+{
+	AutomationList al (Evoral::Parameter (FadeInAutomation), Temporal::TimeDomainProvider (Temporal::AudioTime));
+
+	al.add (timepos_t (0), 1, false, false);
+	al.add (timepos_t (10), 2, false, false);
+
+	std::string const s1 = serialized_events (al);
+	CPPUNIT_ASSERT (!s1.empty ());
+
+	/* unchanged list, same state */
+	CPPUNIT_ASSERT_EQUAL (s1, serialized_events (al));
+
+	/* any modification must be reflected */
+	al.add (timepos_t (20), 0.5, false, false);
+	std::string const s2 = serialized_events (al);
+	CPPUNIT_ASSERT (s1 != s2);
+
+	al.modify (al.begin (), timepos_t (0), 0.25);
+	std::string const s3 = serialized_events (al);
+	CPPUNIT_ASSERT (s2 != s3);
+
+	al.erase (al.begin ());
+	std::string const s4 = serialized_events (al);
+	CPPUNIT_ASSERT (s3 != s4);
+
+	/* undo-like restore of a previous state */
+	AutomationList copy (al);
+	al.add (timepos_t (30), 1, false, false);
+	CPPUNIT_ASSERT (s4 != serialized_events (al));
+	al.freeze ();
+	al = copy;
+	al.thaw ();
+	CPPUNIT_ASSERT_EQUAL (s4, serialized_events (al));
+
+	/* guard points added at the start of a write pass */
+	al.set_in_write_pass (true, true, timepos_t (15));
+	al.set_in_write_pass (false);
+	CPPUNIT_ASSERT (s4 != serialized_events (al));
+}
+
+void
+AutomationListPropertyTest::sidecarTest ()
+{
+	std::string const dir = new_test_output_dir ("automation_sidecar");
+
+	AutomationList al (Evoral::Parameter (GainAutomation), Temporal::TimeDomainProvider (Temporal::AudioTime));
+
+	size_t const n = AutomationSidecar::min_events + 10;
+	for (size_t i = 0; i < n; ++i) {
+		al.add (timepos_t (i * 64), (i % 100) / 100.0, false, false);
+	}
+
+	XMLNode* state;
+	{
+		AutomationSidecar::Saving sv (true, dir);
+		state = &al.get_state ();
+	}
+
+	/* events are referenced, not inline */
+	XMLNode const* events = state->child (X_("events"));
+	CPPUNIT_ASSERT (events);
+	CPPUNIT_ASSERT (events->children ().empty ());
+	std::string name;
+	CPPUNIT_ASSERT (events->get_property (X_("sidecar"), name));
+	CPPUNIT_ASSERT (Glib::file_test (Glib::build_filename (dir, name), Glib::FILE_TEST_EXISTS));
+
+	/* without a Saving scope, events are stored inline */
+	CPPUNIT_ASSERT (!serialized_events (al).empty ());
+
+	AutomationSidecar::set_directory (dir);
+
+	AutomationList loaded (Evoral::Parameter (GainAutomation), Temporal::TimeDomainProvider (Temporal::AudioTime));
+	CPPUNIT_ASSERT_EQUAL (0, loaded.set_state (*state, PBD::Stateful::current_state_version));
+	CPPUNIT_ASSERT_EQUAL (al.size (), loaded.size ());
+	CPPUNIT_ASSERT_EQUAL (serialized_events (al), serialized_events (loaded));
+
+	/* state imported from another session has its events inlined */
+	XMLNode imported_state (*state);
+	AutomationSidecar::set_directory ("");
+	AutomationSidecar::inline_events (imported_state, dir);
+	CPPUNIT_ASSERT (!imported_state.child (X_("events"))->property (X_("sidecar")));
+
+	AutomationList imported (Evoral::Parameter (GainAutomation), Temporal::TimeDomainProvider (Temporal::AudioTime));
+	CPPUNIT_ASSERT_EQUAL (0, imported.set_state (imported_state, PBD::Stateful::current_state_version));
+	CPPUNIT_ASSERT_EQUAL (serialized_events (al), serialized_events (imported));
+
+	/* a file that does not match the session is rejected */
+	state->child (X_("events"))->set_property (X_("checksum"), (uint64_t) 0);
+	AutomationList mismatch (Evoral::Parameter (GainAutomation), Temporal::TimeDomainProvider (Temporal::AudioTime));
+	mismatch.set_state (*state, PBD::Stateful::current_state_version);
+	CPPUNIT_ASSERT (mismatch.empty ());
+
+	delete state;
+}
@@ -26,6 +26,8 @@ class AutomationListPropertyTest : public CppUnit::TestFixture
 	CPPUNIT_TEST_SUITE (AutomationListPropertyTest);
 	CPPUNIT_TEST (basicTest);
 	CPPUNIT_TEST (undoTest);
+	CPPUNIT_TEST (cachedStateTest);
+	CPPUNIT_TEST (sidecarTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -33,6 +35,8 @@ public:
 	void tearDown ();
 	void basicTest ();
 	void undoTest ();
+	void cachedStateTest ();
+	void sidecarTest ();
 
 private:
 	Temporal::superclock_t _saved_superclock_ticks_per_second;
@@ -68,6 +68,32 @@ FPUTest::run (size_t align_max, float const max_diff)
 			default_mix_buffers_with_gain (&_comp1[off], &_comp2[off], cnt, 0.45);
 			compare (string_compose ("Mix Buffers w/gain not aligned off: %1 cnt: %2", off, cnt), cnt, max_diff);
 
+			/* apply gain vector */
+			apply_gain_vector_to_buffer (&_test1[off], &_test2[off], cnt);
+			default_apply_gain_vector_to_buffer (&_comp1[off], &_comp2[off], cnt);
+			compare (string_compose ("Apply Gain Vector not aligned off: %1 cnt: %2", off, cnt), cnt);
+
+			/* mix buffers w/gain vector */
+			mix_buffers_with_gain_vector (&_test1[off], &_test2[off], &_test2[off], cnt);
+			default_mix_buffers_with_gain_vector (&_comp1[off], &_comp2[off], &_comp2[off], cnt);
+			compare (string_compose ("Mix Buffers w/gain vector not aligned off: %1 cnt: %2", off, cnt), cnt, max_diff);
+
+			/* sum of squares, summation order differs */
+			float ss_test = sum_of_squares (&_test1[off], cnt);
+			float ss_comp = default_sum_of_squares (&_comp1[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Sum of squares not aligned off: %1 cnt: %2", off, cnt), fabsf (ss_test - ss_comp) <= 1e-5 * ss_comp);
+
+			/* (de)interleave */
+			for (uint32_t n_channels = 2; n_channels < 4; ++n_channels) {
+				interleave_channel (&_test1[off], &_test2[off], cnt, n_channels - 1, n_channels);
+				default_interleave_channel (&_comp1[off], &_comp2[off], cnt, n_channels - 1, n_channels);
+				compare (string_compose ("Interleave %3 chn not aligned off: %1 cnt: %2", off, cnt, n_channels), off + cnt * n_channels);
+
+				deinterleave_channel (&_test1[off], &_test2[off], cnt, n_channels - 1, n_channels);
+				default_deinterleave_channel (&_comp1[off], &_comp2[off], cnt, n_channels - 1, n_channels);
+				compare (string_compose ("Deinterleave %3 chn not aligned off: %1 cnt: %2", off, cnt, n_channels), off + cnt);
+			}
+
 			/* copy vector */
 			copy_vector (&_test1[off], &_test2[off], cnt);
 			default_copy_vector (&_comp1[off], &_comp2[off], cnt);
@@ -123,6 +149,12 @@ FPUTest::avxFmaTest ()
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
 
+	apply_gain_vector_to_buffer  = x86_sse_avx_apply_gain_vector_to_buffer;
+	mix_buffers_with_gain_vector = x86_sse_avx_mix_buffers_with_gain_vector;
+	sum_of_squares               = x86_sse_avx_sum_of_squares;
+	interleave_channel           = x86_sse_interleave_channel;
+	deinterleave_channel         = x86_sse_deinterleave_channel;
+
 	run (align_max, FLT_EPSILON);
 }
 
@@ -150,6 +182,12 @@ FPUTest::avxTest ()
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
 
+	apply_gain_vector_to_buffer  = x86_sse_avx_apply_gain_vector_to_buffer;
+	mix_buffers_with_gain_vector = x86_sse_avx_mix_buffers_with_gain_vector;
+	sum_of_squares               = x86_sse_avx_sum_of_squares;
+	interleave_channel           = x86_sse_interleave_channel;
+	deinterleave_channel         = x86_sse_deinterleave_channel;
+
 	run (align_max);
 }
 
@@ -177,6 +215,12 @@ FPUTest::avx512fTest ()
 	mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 	copy_vector           = x86_avx512f_copy_vector;
 
+	apply_gain_vector_to_buffer  = x86_avx512f_apply_gain_vector_to_buffer;
+	mix_buffers_with_gain_vector = x86_avx512f_mix_buffers_with_gain_vector;
+	sum_of_squares               = x86_avx512f_sum_of_squares;
+	interleave_channel           = x86_sse_interleave_channel;
+	deinterleave_channel         = x86_sse_deinterleave_channel;
+
 	run (align_max, FLT_EPSILON);
 }
 
@@ -204,6 +248,12 @@ FPUTest::sseTest ()
 	mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
 
+	apply_gain_vector_to_buffer  = x86_sse_apply_gain_vector_to_buffer;
+	mix_buffers_with_gain_vector = x86_sse_mix_buffers_with_gain_vector;
+	sum_of_squares               = x86_sse_sum_of_squares;
+	interleave_channel           = x86_sse_interleave_channel;
+	deinterleave_channel         = x86_sse_deinterleave_channel;
+
 	run (align_max);
 }
 
@@ -228,6 +278,12 @@ FPUTest::neonTest ()
 	mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 	copy_vector           = arm_neon_copy_vector;
 
+	apply_gain_vector_to_buffer  = arm_neon_apply_gain_vector_to_buffer;
+	mix_buffers_with_gain_vector = arm_neon_mix_buffers_with_gain_vector;
+	sum_of_squares               = arm_neon_sum_of_squares;
+	interleave_channel           = arm_neon_interleave_channel;
+	deinterleave_channel         = arm_neon_deinterleave_channel;
+
 	run (128);
 }
 
@@ -252,6 +308,12 @@ FPUTest::veclibTest ()
 	mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
 
+	apply_gain_vector_to_buffer  = veclib_apply_gain_vector_to_buffer;
+	mix_buffers_with_gain_vector = veclib_mix_buffers_with_gain_vector;
+	sum_of_squares               = veclib_sum_of_squares;
+	interleave_channel           = default_interleave_channel;
+	deinterleave_channel         = default_deinterleave_channel;
+
 #ifdef  __aarch64__
 	run (16, FLT_EPSILON);
 #else
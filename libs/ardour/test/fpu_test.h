@@ -48,6 +48,12 @@ private:
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
 
+	ARDOUR::apply_gain_vector_to_buffer_t  apply_gain_vector_to_buffer;
+	ARDOUR::mix_buffers_with_gain_vector_t mix_buffers_with_gain_vector;
+	ARDOUR::sum_of_squares_t               sum_of_squares;
+	ARDOUR::interleave_channel_t           interleave_channel;
+	ARDOUR::deinterleave_channel_t         deinterleave_channel;
+
 	size_t _size;
 
 	float* _test1;
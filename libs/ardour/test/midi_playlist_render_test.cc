@@ -0,0 +1,141 @@
+#include <utility>
+
+#include "pbd/compose.h"
+
+#include "ardour/midi_channel_filter.h"
+#include "ardour/midi_playlist.h"
+#include "ardour/midi_region.h"
+#include "ardour/midi_source.h"
+#include "ardour/playlist_factory.h"
+#include "ardour/region_factory.h"
+#include "ardour/rt_midibuffer.h"
+#include "ardour/session.h"
+
+#include "midi_playlist_render_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiPlaylistRenderTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace Temporal;
+
+typedef vector<pair<samplepos_t, vector<uint8_t> > > Events;
+
+static Events
+as_vector (RTMidiBuffer const& buf)
+{
+	Events ev;
+	for (size_t n = 0; n < buf.size (); ++n) {
+		uint32_t       size;
+		uint8_t const* data = buf.bytes (buf[n], size);
+		ev.push_back (make_pair (buf[n].timestamp, vector<uint8_t> (data, data + size)));
+	}
+	return ev;
+}
+
+void
+MidiPlaylistRenderTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	_playlist = std::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (DataType::MIDI, *_session, "test"));
+
+	/* a note on every beat, with a CC and a sysex (which is not stored inline) between */
+	std::shared_ptr<MidiSource> ms = _session->create_midi_source_for_session ("test");
+
+	{
+		MidiSource::WriterLock lock (ms->mutex ());
+		ms->mark_streaming_midi_write_started (lock, Sustained);
+		for (int b = 0; b < 16; ++b) {
+			uint8_t const on[]    = { 0x90, (uint8_t) (48 + b), 100 };
+			uint8_t const cc[]    = { 0xb0, 7, (uint8_t) (b * 8) };
+			uint8_t const sysex[] = { 0xf0, 0x7d, (uint8_t) b, 0x01, 0x02, 0xf7 };
+			uint8_t const off[]   = { 0x80, (uint8_t) (48 + b), 0 };
+			ms->append_event_beats (lock, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (b, 0), sizeof (on), on));
+			ms->append_event_beats (lock, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (b, 240), sizeof (cc), cc));
+			ms->append_event_beats (lock, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (b, 480), sizeof (sysex), sysex));
+			ms->append_event_beats (lock, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (b, 960), sizeof (off), off));
+		}
+		ms->mark_streaming_write_completed (lock, timecnt_t (Beats (16, 0)));
+		ms->load_model (lock);
+	}
+
+	/* overlapping regions, transparent so that the playlist is rendered
+	 * by merging them, which allows for incremental updates.
+	 */
+	for (int i = 0; i < 8; ++i) {
+		PropertyList plist;
+		plist.add (Properties::start, timepos_t (Beats (i % 4, 0)));
+		plist.add (Properties::length, timecnt_t (Beats (4 + i % 3, 0)));
+		plist.add (Properties::name, string_compose ("mr%1", i));
+
+		std::shared_ptr<Region> r = RegionFactory::create (ms, plist);
+		r->set_opaque (false);
+		_playlist->add_region (r, timepos_t (Beats (i * 3, 0)));
+		_regions.push_back (r);
+	}
+}
+
+void
+MidiPlaylistRenderTest::tearDown ()
+{
+	_regions.clear ();
+	_playlist.reset ();
+
+	TestNeedingSession::tearDown ();
+}
+
+/** Render the (modified) playlist, and compare the result with a full
+ * render. A different channel-filter invalidates all cached regions.
+ */
+void
+MidiPlaylistRenderTest::check (char const* what)
+{
+	_playlist->render (0);
+	Events const incremental = as_vector (*_playlist->rendered ());
+
+	MidiChannelFilter filter;
+	_playlist->render (&filter);
+	Events const full = as_vector (*_playlist->rendered ());
+
+	CPPUNIT_ASSERT_MESSAGE (what, !full.empty ());
+	CPPUNIT_ASSERT_MESSAGE (what, incremental == full);
+
+	/* back to the state the next incremental render starts from */
+	_playlist->render (0);
+	CPPUNIT_ASSERT_MESSAGE (what, full == as_vector (*_playlist->rendered ()));
+}
+
+void
+MidiPlaylistRenderTest::incrementalTest ()
+{
+	check ("initial");
+
+	_playlist->render (0);
+	check ("unchanged");
+
+	_regions[2]->set_position (timepos_t (Beats (1, 0)));
+	check ("move");
+
+	_regions[5]->set_position (timepos_t (Beats (40, 0)));
+	check ("move past the end");
+
+	_regions[3]->trim_end (_regions[3]->position () + timecnt_t (Beats (2, 0)));
+	check ("trim end");
+
+	_regions[6]->trim_front (_regions[6]->position () + timecnt_t (Beats (1, 0)));
+	check ("trim front");
+
+	_regions[1]->set_muted (true);
+	check ("mute");
+
+	_regions[1]->set_muted (false);
+	check ("unmute");
+
+	_playlist->remove_region (_regions[4]);
+	check ("remove");
+
+	_regions[0]->set_position (timepos_t (Beats (20, 0)));
+	_regions[7]->set_position (timepos_t (Beats (0, 0)));
+	check ("move two regions");
+}
@@ -0,0 +1,27 @@
+#include <vector>
+
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class MidiPlaylist;
+	class Region;
+}
+
+class MidiPlaylistRenderTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiPlaylistRenderTest);
+	CPPUNIT_TEST (incrementalTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void incrementalTest ();
+
+private:
+	void check (char const* what);
+
+	std::shared_ptr<ARDOUR::MidiPlaylist>         _playlist;
+	std::vector<std::shared_ptr<ARDOUR::Region> > _regions;
+};
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "ardour/peak_pyramid.h"
+#include "ardour/types.h"
+
+#include "peak_pyramid_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PeakPyramidTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static const samplecnt_t spp = 256;
+
+void
+PeakPyramidTest::setUp ()
+{
+	_dir      = new_test_output_dir ("peak_pyramid");
+	_peakfile = Glib::build_filename (_dir, "test.peak");
+
+	/* a bit more than two blocks, not a multiple of any level */
+	_peaks.resize (2 * 65536 + 1234);
+	srand (42);
+	for (auto& p : _peaks) {
+		p.min = -(rand () % 1000) / 1000.f;
+		p.max = (rand () % 1000) / 1000.f;
+	}
+
+	FILE* f = fopen (_peakfile.c_str (), "wb");
+	CPPUNIT_ASSERT (f);
+	CPPUNIT_ASSERT_EQUAL (_peaks.size (), fwrite (&_peaks[0], sizeof (PeakData), _peaks.size (), f));
+	fclose (f);
+}
+
+void
+PeakPyramidTest::check (string const& pyramid)
+{
+	CPPUNIT_ASSERT (PeakPyramid::usable (pyramid, _peakfile, spp));
+
+	samplecnt_t const length = _peaks.size () * spp;
+
+	for (double spv = 4096; spv < length; spv *= 3.7) {
+		samplepos_t const start = _peaks.size () / 3 * spp + 17;
+		samplecnt_t const cnt   = min<samplecnt_t> (length - start, spv * 100);
+		samplecnt_t const np    = cnt / spv;
+
+		if (np < 1) {
+			continue;
+		}
+
+		vector<PeakData> out (np);
+		CPPUNIT_ASSERT_EQUAL (0, PeakPyramid::read_peaks (pyramid, spp, &out[0], np, start, cnt, spv));
+
+		/* the coarsest level with at least `factor` entries per visual peak */
+		uint32_t level = PeakPyramid::n_levels;
+		while (level > 0 && spp * pow (PeakPyramid::factor, level + 1) > spv) {
+			--level;
+		}
+		size_t const      level_peaks = pow (PeakPyramid::factor, level);
+		samplecnt_t const level_spp   = spp * level_peaks;
+
+		/* every visual peak is the min/max of exactly the peakfile
+		 * peaks of the level entries it touches.
+		 */
+		for (samplecnt_t p = 0; p < np; ++p) {
+			double const s = start + p * spv;
+			double const e = min<double> (start + cnt, start + (p + 1) * spv);
+			size_t const a = floor (s / level_spp) * level_peaks;
+			size_t const b = min<size_t> (_peaks.size (), ceil (e / level_spp) * level_peaks);
+
+			CPPUNIT_ASSERT (a < b);
+
+			PeakData expected = _peaks[a];
+			for (size_t i = a + 1; i < b; ++i) {
+				expected.min = min (expected.min, _peaks[i].min);
+				expected.max = max (expected.max, _peaks[i].max);
+			}
+			CPPUNIT_ASSERT_EQUAL (expected.min, out[p].min);
+			CPPUNIT_ASSERT_EQUAL (expected.max, out[p].max);
+		}
+	}
+
+	/* too fine a resolution, the peakfile has to be used */
+	PeakData pd;
+	CPPUNIT_ASSERT_EQUAL (1, PeakPyramid::read_peaks (pyramid, spp, &pd, 1, 0, 1024, 1024));
+}
+
+void
+PeakPyramidTest::buildTest ()
+{
+	string const pyramid = Glib::build_filename (_dir, "build.pyramid");
+	CPPUNIT_ASSERT_EQUAL (0, PeakPyramid::build (pyramid, _peakfile, spp));
+	check (pyramid);
+}
+
+void
+PeakPyramidTest::incrementalTest ()
+{
+	string const pyramid = Glib::build_filename (_dir, "incremental.pyramid");
+
+	PeakPyramid pp (pyramid, spp);
+	CPPUNIT_ASSERT_EQUAL (0, pp.open ());
+
+	/* like a capture, in chunks of varying size */
+	size_t pos = 0;
+	while (pos < _peaks.size ()) {
+		size_t const n = min<size_t> (_peaks.size () - pos, 1 + rand () % 5000);
+		CPPUNIT_ASSERT_EQUAL (0, pp.append (&_peaks[pos], n, pos));
+		pos += n;
+	}
+
+	/* overwriting data, the pyramid is rebuilt from the peakfile */
+	CPPUNIT_ASSERT_EQUAL (0, pp.append (&_peaks[10], 1, 10));
+
+	CPPUNIT_ASSERT_EQUAL (0, pp.finish (_peakfile));
+	check (pyramid);
+}
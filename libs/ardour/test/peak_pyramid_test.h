@@ -0,0 +1,29 @@
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/types.h"
+
+class PeakPyramidTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (PeakPyramidTest);
+	CPPUNIT_TEST (buildTest);
+	CPPUNIT_TEST (incrementalTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown () {}
+
+	void buildTest ();
+	void incrementalTest ();
+
+private:
+	void check (std::string const& pyramid);
+
+	std::string                   _dir;
+	std::string                   _peakfile;
+	std::vector<ARDOUR::PeakData> _peaks;
+};
@@ -0,0 +1,114 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "pbd/microseconds.h"
+
+#include "evoral/ControlList.h"
+#include "evoral/Curve.h"
+
+#include "ardour/ardour.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace Temporal;
+
+static const char* localedir = LOCALEDIR;
+
+static void
+bench (Evoral::ControlList& cl, const char* name, samplecnt_t length, pframes_t block_size)
+{
+	float* vec = new float[block_size];
+	double sum = 0;
+
+	/* one block evaluation per cycle */
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (samplepos_t s = 0; s + block_size <= length; s += block_size) {
+		cl.curve ().get_vector (timepos_t (s), timepos_t (s + block_size), vec, block_size);
+		sum += vec[0];
+	}
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+
+	/* point by point */
+	for (samplepos_t s = 0; s + block_size <= length; s += block_size) {
+		for (pframes_t i = 0; i < block_size; ++i) {
+			vec[i] = cl.unlocked_eval (timepos_t (s + i));
+		}
+		sum += vec[0];
+	}
+	PBD::microseconds_t t2 = PBD::get_microseconds ();
+
+	printf ("%-12s block: %8.1f ms  per-sample: %8.1f ms  x%.2f\n",
+	        name,
+	        (t1 - t0) / 1e3,
+	        (t2 - t1) / 1e3,
+	        t1 > t0 ? (double)(t2 - t1) / (t1 - t0) : 0);
+
+	/* prevent the compiler from optimizing away the loops */
+	if (sum < 0) {
+		printf ("%f\n", sum);
+	}
+
+	delete[] vec;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int       n_points   = 100000;
+	pframes_t block_size = 1024;
+
+	if (argc > 1) {
+		n_points = atoi (argv[1]);
+	}
+	if (argc > 2) {
+		block_size = atoi (argv[2]);
+	}
+	if (n_points < 3 || block_size < 1) {
+		cerr << argv[0] << ": [number-of-points [samples-per-block]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	/* dense, touch-recorded like data: a point every 64 samples */
+	samplecnt_t const spacing = 64;
+	samplecnt_t const length  = n_points * spacing;
+
+	printf ("%d points, %u samples per block\n", n_points, block_size);
+
+	Evoral::ControlList::InterpolationStyle styles[] = {
+		Evoral::ControlList::Discrete,
+		Evoral::ControlList::Linear,
+		Evoral::ControlList::Logarithmic,
+		Evoral::ControlList::Exponential
+	};
+	const char* names[] = { "Discrete", "Linear", "Logarithmic", "Exponential" };
+
+	for (int s = 0; s < 4; ++s) {
+		Evoral::Parameter           param (0);
+		Evoral::ParameterDescriptor desc;
+		/* logarithmic needs a positive range, exponential starts at zero */
+		desc.lower = styles[s] == Evoral::ControlList::Logarithmic ? .01 : 0;
+		desc.upper = 2;
+
+		Evoral::ControlList cl (param, desc, TimeDomainProvider (AudioTime));
+		cl.create_curve ();
+		if (!cl.set_interpolation (styles[s])) {
+			cerr << "cannot set interpolation to " << names[s] << "\n";
+			continue;
+		}
+
+		cl.freeze ();
+		for (int i = 0; i < n_points; ++i) {
+			cl.fast_simple_add (timepos_t (i * spacing), .5 + .4 * sin (i * .01));
+		}
+		cl.thaw ();
+
+		bench (cl, names[s], length, block_size);
+	}
+
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -1,6 +1,7 @@
 #include "test_ui.h"
 #include "test_util.h"
 #include "pbd/failed_constructor.h"
+#include "pbd/timing.h"
 #include "ardour/ardour.h"
 #include "ardour/audioengine.h"
 #include "ardour/session.h"
@@ -24,6 +25,7 @@ int main (int argc, char* argv[])
 	create_and_start_dummy_backend ();
 
 	Session* s = 0;
+	PBD::Timing t;
 
 	try {
 		s = load_session (argv[1], argv[2]);
@@ -41,6 +43,9 @@ int main (int argc, char* argv[])
 		exit (EXIT_FAILURE);
 	}
 
+	t.update ();
+	cout << "Loaded session in " << t.elapsed_msecs () << " ms\n";
+
 	AudioEngine::instance()->remove_session ();
 	delete s;
 	AudioEngine::instance()->stop ();
@@ -1,3 +1,5 @@
+#include <iostream>
+
 #include "test_ui.h"
 #include "test_util.h"
 #include "ardour/ardour.h"
@@ -5,6 +7,7 @@
 #include "ardour/midi_region.h"
 #include "ardour/session.h"
 #include "ardour/playlist.h"
+#include "pbd/microseconds.h"
 #include "pbd/stateful_diff_command.h"
 
 using namespace std;
@@ -56,6 +59,37 @@ main (int argc, char* argv[])
 	session->add_command (new StatefulDiffCommand (playlist));
 	session->commit_reversible_command ();
 
+	/* Time region queries, spread across the whole playlist */
+	std::pair<timepos_t, timepos_t> extent = playlist->get_extent ();
+	samplepos_t const len     = extent.second.samples () - extent.first.samples ();
+	int const         n_iter  = 20000;
+	size_t            n_found = 0;
+
+	cout << "INFO: " << playlist->n_regions () << " regions.\n";
+
+	PBD::microseconds_t t0 = PBD::get_microseconds ();
+	for (int i = 0; i < n_iter; ++i) {
+		timepos_t p (extent.first.samples () + (len * (int64_t) i) / n_iter);
+		n_found += playlist->regions_at (p)->size ();
+	}
+	PBD::microseconds_t t1 = PBD::get_microseconds ();
+	for (int i = 0; i < n_iter; ++i) {
+		timepos_t p (extent.first.samples () + (len * (int64_t) i) / n_iter);
+		n_found += playlist->regions_touched (p, p + timecnt_t (1024))->size ();
+	}
+	PBD::microseconds_t t2 = PBD::get_microseconds ();
+	for (int i = 0; i < n_iter; ++i) {
+		timepos_t p (extent.first.samples () + (len * (int64_t) i) / n_iter);
+		n_found += playlist->regions_with_start_within (Temporal::TimeRange (p, p + timecnt_t (8192)))->size ();
+		n_found += playlist->regions_with_end_within (Temporal::TimeRange (p, p + timecnt_t (8192)))->size ();
+	}
+	PBD::microseconds_t t3 = PBD::get_microseconds ();
+
+	cout << "INFO: regions_at:      " << (t1 - t0) / (double) n_iter << " us/query\n";
+	cout << "INFO: regions_touched: " << (t2 - t1) / (double) n_iter << " us/query\n";
+	cout << "INFO: start/end_within: " << (t3 - t2) / (double) (2 * n_iter) << " us/query\n";
+	cout << "INFO: " << n_found << " regions found.\n";
+
 	}
 
 	delete session;
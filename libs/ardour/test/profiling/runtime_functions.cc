@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "pbd/malign.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+static float* buf1;
+static float* buf2;
+static float* gain;
+static float* ilv;
+
+static uint32_t n_samples  = 1024;
+static uint32_t n_channels = 2;
+
+/* run the given kernel `n_iter` times, report throughput in MSamples/sec */
+#define BENCH(NAME, OPT, DFLT, ...)                                        \
+	do {                                                                     \
+		PBD::microseconds_t t0 = PBD::get_microseconds ();                     \
+		for (int i = 0; i < n_iter; ++i) { OPT (__VA_ARGS__); }                \
+		PBD::microseconds_t t1 = PBD::get_microseconds ();                     \
+		for (int i = 0; i < n_iter; ++i) { DFLT (__VA_ARGS__); }               \
+		PBD::microseconds_t t2 = PBD::get_microseconds ();                     \
+		report (NAME, t1 - t0, t2 - t1, n_iter);                               \
+	} while (0)
+
+static void
+report (const char* name, PBD::microseconds_t opt, PBD::microseconds_t dflt, int n_iter)
+{
+	double const n = (double)n_samples * n_iter;
+	printf ("%-30s %9.1f MS/s %9.1f MS/s (default) x%.2f\n",
+	        name,
+	        opt > 0 ? n / opt : 0,
+	        dflt > 0 ? n / dflt : 0,
+	        opt > 0 ? (double)dflt / opt : 0);
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_iter = 100000;
+
+	if (argc > 1) {
+		n_samples = atoi (argv[1]);
+	}
+	if (argc > 2) {
+		n_iter = atoi (argv[2]);
+	}
+	if (n_samples < 1 || n_iter < 1) {
+		cerr << argv[0] << ": [samples-per-block [iterations]]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	cache_aligned_malloc ((void**)&buf1, sizeof (float) * n_samples);
+	cache_aligned_malloc ((void**)&buf2, sizeof (float) * n_samples);
+	cache_aligned_malloc ((void**)&gain, sizeof (float) * n_samples);
+	cache_aligned_malloc ((void**)&ilv, sizeof (float) * n_samples * n_channels);
+
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		buf1[i] = buf2[i] = (i % 100) / 100.f - .5f;
+		gain[i] = 1.f;
+	}
+	for (uint32_t i = 0; i < n_samples * n_channels; ++i) {
+		ilv[i] = 0;
+	}
+
+	printf ("Block size: %u samples, %d iterations\n", n_samples, n_iter);
+
+	float pk = 0;
+	float ss = 0;
+
+	BENCH ("compute_peak", pk += compute_peak, pk += default_compute_peak, buf1, n_samples, 0);
+	BENCH ("apply_gain_to_buffer", apply_gain_to_buffer, default_apply_gain_to_buffer, buf1, n_samples, 1.f);
+	BENCH ("mix_buffers_with_gain", mix_buffers_with_gain, default_mix_buffers_with_gain, buf1, buf2, n_samples, 0.f);
+	BENCH ("mix_buffers_no_gain", mix_buffers_no_gain, default_mix_buffers_no_gain, buf2, buf1, n_samples);
+	BENCH ("apply_gain_vector_to_buffer", apply_gain_vector_to_buffer, default_apply_gain_vector_to_buffer, buf1, gain, n_samples);
+	BENCH ("mix_buffers_with_gain_vector", mix_buffers_with_gain_vector, default_mix_buffers_with_gain_vector, buf1, buf2, gain, n_samples);
+	BENCH ("sum_of_squares", ss += sum_of_squares, ss += default_sum_of_squares, buf1, n_samples);
+	BENCH ("interleave_channel", interleave_channel, default_interleave_channel, ilv, buf1, n_samples, 1, n_channels);
+	BENCH ("deinterleave_channel", deinterleave_channel, default_deinterleave_channel, buf1, ilv, n_samples, 1, n_channels);
+
+	/* prevent the compiler from optimizing away the reductions */
+	if (pk < 0 || ss < 0) {
+		printf ("%f %f\n", pk, ss);
+	}
+
+	cache_aligned_free (buf1);
+	cache_aligned_free (buf2);
+	cache_aligned_free (gain);
+	cache_aligned_free (ilv);
+
+	ARDOUR::cleanup ();
+	return 0;
+}
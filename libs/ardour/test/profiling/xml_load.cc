@@ -0,0 +1,86 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
+
+#include "pbd/microseconds.h"
+#include "pbd/xml++.h"
+
+using namespace std;
+
+/* Compare reading session files via a libxml2 document (--document)
+ * with streaming them into the XMLNode tree (default).
+ *
+ * Peak memory is per process, run each mode separately, e.g.
+ *   xml_load --document sessions/32tracks/32tracks.ardour
+ *   xml_load sessions/32tracks/32tracks.ardour
+ */
+
+static size_t
+count_nodes (XMLNode const& node)
+{
+	size_t n = 1;
+	for (XMLNodeConstIterator i = node.children ().begin (); i != node.children ().end (); ++i) {
+		n += count_nodes (**i);
+	}
+	return n;
+}
+
+int
+main (int argc, char* argv[])
+{
+	bool use_document = false;
+	int  iterations   = 20;
+	int  first        = 1;
+
+	while (first < argc && argv[first][0] == '-') {
+		if (!strcmp (argv[first], "--document")) {
+			use_document = true;
+		} else if (!strcmp (argv[first], "-n") && first + 1 < argc) {
+			iterations = atoi (argv[++first]);
+		} else {
+			break;
+		}
+		++first;
+	}
+
+	if (first >= argc || iterations < 1) {
+		cerr << argv[0] << ": [--document] [-n iterations] <session-file> ...\n";
+		exit (EXIT_FAILURE);
+	}
+
+	for (int f = first; f < argc; ++f) {
+		size_t              nodes = 0;
+		PBD::microseconds_t total = 0;
+
+		for (int i = 0; i < iterations; ++i) {
+			XMLTree             tree;
+			PBD::microseconds_t t0 = PBD::get_microseconds ();
+			bool                ok = use_document ? tree.read_document (argv[f]) : tree.read (argv[f]);
+			total += PBD::get_microseconds () - t0;
+
+			if (!ok || !tree.root ()) {
+				cerr << "cannot read " << argv[f] << "\n";
+				exit (EXIT_FAILURE);
+			}
+			nodes = count_nodes (*tree.root ());
+		}
+
+		printf ("%s: %s, %zu nodes, %.2f ms per read\n",
+		        argv[f], use_document ? "document" : "streaming",
+		        nodes, total / (1e3 * iterations));
+	}
+
+#ifndef PLATFORM_WINDOWS
+	struct rusage ru;
+	if (getrusage (RUSAGE_SELF, &ru) == 0) {
+		printf ("peak resident memory: %ld kB\n", ru.ru_maxrss);
+	}
+#endif
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+#include <set>
+#include <string>
+
+#include "pbd/compose.h"
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/region_factory.h"
+#include "ardour/region_index.h"
+
+#include "region_index_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RegionIndexTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace Temporal;
+
+typedef vector<std::shared_ptr<Region> > Regions;
+
+static Regions
+as_vector (std::shared_ptr<RegionList> rl)
+{
+	return Regions (rl->begin (), rl->end ());
+}
+
+void
+RegionIndexTest::setUp ()
+{
+	AudioRegionTest::setUp ();
+
+	/* more regions than RegionIndex::min_regions, irregularly placed,
+	 * overlapping, and every 6th region starting at the same position
+	 * as the previous one.
+	 */
+	samplepos_t pos = 0;
+	for (int i = 0; i < 48; ++i) {
+		if (i % 6 != 5) {
+			pos = (i * 7919) % 5000;
+		}
+
+		PropertyList plist;
+		plist.add (Properties::start, timepos_t (0));
+		plist.add (Properties::length, timecnt_t (samplecnt_t (20 + (i * 131) % 900)));
+
+		std::shared_ptr<Region> r = RegionFactory::create (_source, plist);
+		r->set_name (string_compose ("ri%1", i));
+		_playlist->add_region (r, timepos_t (pos));
+		_regions.push_back (r);
+	}
+}
+
+void
+RegionIndexTest::tearDown ()
+{
+	_regions.clear ();
+
+	AudioRegionTest::tearDown ();
+}
+
+/** Compare the Playlist's (indexed) region queries with a linear scan
+ * of its RegionList, as done by Playlist when no index is used.
+ */
+void
+RegionIndexTest::check (char const* what)
+{
+	std::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	CPPUNIT_ASSERT (all->size () >= RegionIndex::min_regions);
+
+	/* probe at and around all region boundaries, and on a grid */
+	set<samplepos_t> probes;
+	for (auto const& r : *all) {
+		samplepos_t const s = r->position ().samples ();
+		samplepos_t const e = r->nt_last ().samples ();
+		probes.insert (s);
+		probes.insert (e);
+		probes.insert (e + 1);
+		if (s > 0) {
+			probes.insert (s - 1);
+		}
+	}
+	for (samplepos_t p = 0; p < 6500; p += 53) {
+		probes.insert (p);
+	}
+
+	samplecnt_t const lengths[] = { 0, 1, 50, 400 };
+
+	for (auto const& p : probes) {
+		timepos_t const pos (p);
+
+		Regions expected;
+		for (auto const& r : *all) {
+			if (r->covers (pos)) {
+				expected.push_back (r);
+			}
+		}
+
+		string msg = string_compose ("%1: regions_at %2", what, p);
+		CPPUNIT_ASSERT_MESSAGE (msg, expected == as_vector (_playlist->regions_at (pos)));
+
+		Regions got;
+		_playlist->collect_regions_at (pos, got);
+		CPPUNIT_ASSERT_MESSAGE (msg, expected == got);
+
+		for (auto const& len : lengths) {
+			timepos_t const end (p + len);
+
+			msg = string_compose ("%1: regions_touched %2 .. %3", what, p, p + len);
+
+			expected.clear ();
+			for (auto const& r : *all) {
+				if (r->coverage (pos, end, false) != OverlapNone) {
+					expected.push_back (r);
+				}
+			}
+			CPPUNIT_ASSERT_MESSAGE (msg, expected == as_vector (_playlist->regions_touched (pos, end)));
+			_playlist->collect_regions_touched (pos, end, got, false);
+			CPPUNIT_ASSERT_MESSAGE (msg, expected == got);
+
+			expected.clear ();
+			for (auto const& r : *all) {
+				if (r->coverage (pos, end, true) != OverlapNone) {
+					expected.push_back (r);
+				}
+			}
+			_playlist->collect_regions_touched (pos, end, got, true);
+			CPPUNIT_ASSERT_MESSAGE (msg + " with tail", expected == got);
+
+			TimeRange const range (pos, end);
+
+			msg = string_compose ("%1: regions_with_start_within %2 .. %3", what, p, p + len);
+			expected.clear ();
+			for (auto const& r : *all) {
+				if (r->position () >= range.start () && r->position () < range.end ()) {
+					expected.push_back (r);
+				}
+			}
+			CPPUNIT_ASSERT_MESSAGE (msg, expected == as_vector (_playlist->regions_with_start_within (range)));
+
+			msg = string_compose ("%1: regions_with_end_within %2 .. %3", what, p, p + len);
+			expected.clear ();
+			for (auto const& r : *all) {
+				if (r->nt_last () >= range.start () && r->nt_last () < range.end ()) {
+					expected.push_back (r);
+				}
+			}
+			CPPUNIT_ASSERT_MESSAGE (msg, expected == as_vector (_playlist->regions_with_end_within (range)));
+		}
+	}
+}
+
+void
+RegionIndexTest::queryTest ()
+{
+	check ("initial");
+
+	/* add */
+	PropertyList plist;
+	plist.add (Properties::start, timepos_t (0));
+	plist.add (Properties::length, timecnt_t (samplecnt_t (3000)));
+	std::shared_ptr<Region> r = RegionFactory::create (_source, plist);
+	_playlist->add_region (r, _regions[10]->position ());
+	_regions.push_back (r);
+	check ("add");
+
+	/* remove, one with a shared start */
+	_playlist->remove_region (_regions[11]);
+	_playlist->remove_region (_regions[20]);
+	check ("remove");
+
+	/* move, onto the start of another region and past the end */
+	_regions[3]->set_position (_regions[30]->position ());
+	_regions[40]->set_position (timepos_t (6000));
+	_regions[0]->set_position (timepos_t (2500));
+	check ("move");
+
+	/* trim both ends */
+	_regions[7]->trim_end (_regions[7]->position () + timecnt_t (samplecnt_t (5)));
+	_regions[25]->trim_front (_regions[25]->position () + timecnt_t (samplecnt_t (10)));
+	_regions[33]->trim_end (_regions[33]->nt_last () + timecnt_t (samplecnt_t (700)));
+	check ("trim");
+}
@@ -0,0 +1,21 @@
+#include <vector>
+
+#include "audio_region_test.h"
+
+class RegionIndexTest : public AudioRegionTest
+{
+	CPPUNIT_TEST_SUITE (RegionIndexTest);
+	CPPUNIT_TEST (queryTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void queryTest ();
+
+private:
+	void check (char const* what);
+
+	std::vector<std::shared_ptr<ARDOUR::Region> > _regions;
+};
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <limits>
+
+#include "ardour/rt_midibuffer.h"
+
+#include "rt_midibuffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RTMidiBufferTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+struct TestEvent {
+	samplepos_t          when;
+	std::vector<uint8_t> data;
+};
+
+/* sorted by time, inline events and sysex (which are kept in the pool) */
+static const TestEvent events[] = {
+	{  0, { 0x90, 60, 100 } },
+	{ 10, { 0xf0, 0x7e, 0x7f, 0x06, 0x01, 0xf7 } },
+	{ 20, { 0x80, 60, 0 } },
+	{ 20, { 0xb0, 7, 64 } },
+	{ 30, { 0xf0, 0x43, 0x10, 0x4c, 0x00, 0x00, 0x7e, 0x00, 0xf7 } },
+	{ 40, { 0xc0, 5 } },
+};
+
+static const size_t n_events = sizeof (events) / sizeof (events[0]);
+
+void
+RTMidiBufferTest::fill (RTMidiBuffer& buf, samplepos_t offset)
+{
+	for (auto const& e : events) {
+		buf.write (e.when + offset, Evoral::MIDI_EVENT, e.data.size (), e.data.data ());
+	}
+}
+
+void
+RTMidiBufferTest::check_event (RTMidiBuffer const& buf, size_t n, samplepos_t when, std::vector<uint8_t> const& data)
+{
+	uint32_t       size;
+	uint8_t const* bytes = buf.bytes (buf[n], size);
+
+	CPPUNIT_ASSERT_EQUAL (when, buf[n].timestamp);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) data.size (), size);
+	CPPUNIT_ASSERT (std::equal (data.begin (), data.end (), bytes));
+}
+
+void
+RTMidiBufferTest::appendTest ()
+{
+	RTMidiBuffer src;
+	fill (src, 0);
+	CPPUNIT_ASSERT_EQUAL (n_events, src.size ());
+
+	/* events at exactly `start` are included, at `end` are not */
+	RTMidiBuffer dst;
+	dst.append (src, 10, 30);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, dst.size ());
+	for (size_t n = 0; n < 3; ++n) {
+		check_event (dst, n, events[n + 1].when, events[n + 1].data);
+	}
+
+	/* empty ranges, and ranges without events */
+	dst.append (src, 20, 20);
+	dst.append (src, 41, 100);
+	dst.append (src, -100, 0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, dst.size ());
+
+	/* continue where the previous range ended, adding to the pool */
+	dst.append (src, 30, 41);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 5, dst.size ());
+	for (size_t n = 0; n < 5; ++n) {
+		check_event (dst, n, events[n + 1].when, events[n + 1].data);
+	}
+
+	/* everything */
+	RTMidiBuffer all;
+	all.append (src, std::numeric_limits<samplepos_t>::min (), max_samplepos);
+	CPPUNIT_ASSERT_EQUAL (n_events, all.size ());
+	for (size_t n = 0; n < n_events; ++n) {
+		check_event (all, n, events[n].when, events[n].data);
+	}
+
+	/* many events, the buffer and pool have to grow */
+	RTMidiBuffer big;
+	for (samplepos_t offset = 0; offset < 100000; offset += 100) {
+		fill (big, offset);
+	}
+	RTMidiBuffer part;
+	part.append (big, 50010, 60010);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100 * n_events, part.size ());
+	for (size_t n = 0; n < part.size (); ++n) {
+		TestEvent const& e (events[(n + 1) % n_events]);
+		check_event (part, n, 50000 + 100 * ((n + 1) / n_events) + e.when, e.data);
+	}
+}
+
+void
+RTMidiBufferTest::swapTest ()
+{
+	RTMidiBuffer a;
+	RTMidiBuffer b;
+
+	fill (a, 0);
+	b.write (500, Evoral::MIDI_EVENT, events[4].data.size (), events[4].data.data ());
+
+	a.swap (b);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, a.size ());
+	check_event (a, 0, 500, events[4].data);
+
+	CPPUNIT_ASSERT_EQUAL (n_events, b.size ());
+	for (size_t n = 0; n < n_events; ++n) {
+		check_event (b, n, events[n].when, events[n].data);
+	}
+
+	/* both remain usable, with their own storage */
+	a.write (600, Evoral::MIDI_EVENT, events[1].data.size (), events[1].data.data ());
+	fill (b, 1000);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, a.size ());
+	check_event (a, 0, 500, events[4].data);
+	check_event (a, 1, 600, events[1].data);
+
+	CPPUNIT_ASSERT_EQUAL (2 * n_events, b.size ());
+	for (size_t n = 0; n < 2 * n_events; ++n) {
+		check_event (b, n, events[n % n_events].when + (n < n_events ? 0 : 1000), events[n % n_events].data);
+	}
+
+	/* clear, then swap back */
+	b.clear ();
+	a.swap (b);
+	CPPUNIT_ASSERT (a.empty ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, b.size ());
+	check_event (b, 1, 600, events[1].data);
+}
@@ -0,0 +1,26 @@
+#include <cstdint>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/rt_midibuffer.h"
+
+class RTMidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RTMidiBufferTest);
+	CPPUNIT_TEST (appendTest);
+	CPPUNIT_TEST (swapTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp () {}
+	void tearDown () {}
+
+	void appendTest ();
+	void swapTest ();
+
+private:
+	void fill (ARDOUR::RTMidiBuffer&, ARDOUR::samplepos_t offset);
+	void check_event (ARDOUR::RTMidiBuffer const&, size_t n, ARDOUR::samplepos_t when, std::vector<uint8_t> const&);
+};
@@ -621,6 +621,12 @@ Track::do_refill ()
 	return _disk_reader->do_refill ();
 }
 
+int
+Track::prefetch_locate_targets (std::vector<samplepos_t> const& targets)
+{
+	return _disk_reader->prefetch_locate_targets (targets);
+}
+
 int
 Track::do_flush (RunContext c, bool force)
 {
@@ -1346,6 +1346,9 @@ Trigger::start_and_roll_to (samplepos_t start_pos, samplepos_t end_position, Tri
 
 AudioTrigger::AudioData::~AudioData ()
 {
+	if (!owned) {
+		return;
+	}
 	for (auto & s : *this) {
 		delete [] s;
 	}
@@ -1361,7 +1364,7 @@ AudioTrigger::AudioData::alloc (samplecnt_t cnt, uint32_t nchans)
 	}
 	length = 0;
 	capacity = cnt;
-
+	owned = true;
 }
 
 samplecnt_t
@@ -1381,6 +1384,7 @@ AudioTrigger::AudioData::append (Sample const * src, samplecnt_t cnt, uint32_t c
 
 AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	: Trigger (n, b)
+	, _data_trash_pending (false)
 	, _stretcher (0)
 	, _start_offset (0)
 	, read_index (0)
@@ -1390,6 +1394,18 @@ AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	, got_stretcher_padding (false)
 	, to_pad (0)
 	, to_drop (0)
+	, _render (0)
+	, _pending_render (0)
+	, _render_trash (0)
+	, _render_requested (false)
+	, _render_failed_bpm (0)
+	, _data_generation (0)
+	, _use_render (false)
+	, _render_switch (false)
+	, _render_index (0)
+	, _retrigger_index (0)
+	, _render_bpm (0)
+	, _render_bpm_cycles (0)
 {
 }
 
@@ -1397,6 +1413,9 @@ AudioTrigger::~AudioTrigger ()
 {
 	drop_data ();
 	delete _stretcher;
+	delete _render;
+	delete _pending_render.load ();
+	delete _render_trash.load ();
 }
 
 Sample const *
@@ -1409,6 +1428,16 @@ AudioTrigger::audio_data (size_t n) const
 	return nullptr;
 }
 
+Sample const *
+AudioTrigger::clip_data (uint32_t chn, samplepos_t pos, samplecnt_t cnt)
+{
+	if (data[chn]) {
+		return data[chn] + pos;
+	}
+	/* not in memory */
+	return _stream->read (chn, pos, cnt);
+}
+
 void
 AudioTrigger::set_stretch_mode (Trigger::StretchMode sm)
 {
@@ -1417,6 +1446,7 @@ AudioTrigger::set_stretch_mode (Trigger::StretchMode sm)
 	}
 
 	_stretch_mode = sm;
+	invalidate_render ();
 	send_property_change (Properties::stretch_mode);
 	_box.session().set_dirty();
 }
@@ -1442,6 +1472,7 @@ AudioTrigger::set_segment_tempo (double t)
 	if (_segment_tempo != t) {
 
 		_segment_tempo = t;
+		invalidate_render ();
 
 		/*beatcnt is a derived property from segment tempo and the file's length*/
 		const double seconds = (double) data.length  / _box.session().sample_rate();
@@ -1535,6 +1566,10 @@ AudioTrigger::set_state (const XMLNode& node, int version)
 	node.get_property (X_("start"), t);
 	_start_offset = t.samples();
 
+	if (_stream) {
+		_stream->set_anchor (_start_offset, false);
+	}
+
 	/* we've changed our internal values; we need to update our queued UIState or they will be lost when UIState is applied */
 	copy_to_ui_state ();
 
@@ -1546,6 +1581,10 @@ AudioTrigger::set_start (timepos_t const & s)
 {
 	/* XXX better minimum size needed */
 	_start_offset = std::max (samplepos_t (4096), s.samples ());
+
+	if (_stream) {
+		_stream->set_anchor (_start_offset, false);
+	}
 }
 
 void
@@ -1840,7 +1879,14 @@ AudioTrigger::estimate_tempo ()
 
 			breakfastquay::MiniBPM mbpm (_box.session().sample_rate());
 
-			_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], data.length);
+			if (data[0]) {
+				_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], data.length);
+			} else {
+				/* streamed from disk, use what is in memory */
+				samplecnt_t   n;
+				Sample const* head = _stream->head (n);
+				_estimated_tempo = head ? mbpm.estimateTempoOfSamples (head, n) : 0.;
+			}
 
 			//cerr << name() << "MiniBPM Estimated: " << _estimated_tempo << " bpm from " << (double) data.length / _box.session().sample_rate() << " seconds\n";
 		}
@@ -1960,10 +2006,16 @@ AudioTrigger::setup_stretcher ()
 void
 AudioTrigger::drop_data ()
 {
-	for (auto& d : data) {
-		delete [] d;
+	if (data.owned) {
+		for (auto& d : data) {
+			delete [] d;
+		}
 	}
 	data.clear ();
+	data.owned = true;
+	_shared_data.reset ();
+	_stream.reset ();
+	invalidate_render ();
 }
 
 void
@@ -1978,8 +2030,27 @@ AudioTrigger::captured (SlotArmInfo& ai, BufferSet&)
 
 	data.clear ();
 
+	/* the previous clip may be shared with other triggers, or streamed
+	 * from disk. Release it in the TriggerBoxThread, so that its clip
+	 * memory is returned to the cache and it is no longer refilled.
+	 */
+	if (_shared_data || _stream) {
+		if (!_data_trash_pending.load ()) {
+			_shared_data_trash = std::move (_shared_data);
+			_stream_trash      = std::move (_stream);
+			_data_trash_pending.store (true);
+			TriggerBox::worker->request_drop_data (this);
+		} else {
+			/* previous trash was not yet collected, unlikely */
+			_shared_data.reset ();
+			_stream.reset ();
+		}
+	}
+
 	data.length = ai.audio_buf.length;
 	data.capacity = ai.audio_buf.capacity;
+	data.owned = true;
+	invalidate_render ();
 
 	/* This AudioBuffer does not own any data, it is just a shell to make
 	   using Amp::apply_gain() possible.
@@ -2027,13 +2098,24 @@ AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
 	try {
 		samplecnt_t len = ar->length_samples();
 
-		data.alloc (len, nchans);
+		_shared_data = AudioClipCache::get (ar);
 
-		for (uint32_t n = 0; n < nchans; ++n) {
-			ar->read (data[n], 0, len, n);
+		if (_shared_data) {
+			data.assign (_shared_data->begin (), _shared_data->end ());
+		} else {
+			try {
+				_stream.reset (new AudioClipStream (ar));
+			} catch (failed_constructor&) {
+				error << string_compose (_("Not enough clip memory to play \"%1\", increase the clip memory limit"), ar->name ()) << endmsg;
+				throw;
+			}
+			_stream->set_anchor (_start_offset, true);
+			data.assign (nchans, nullptr);
 		}
 
-		data.length = len;
+		data.owned    = false;
+		data.length   = len;
+		data.capacity = len;
 		set_name (ar->name());
 
 	} catch (...) {
@@ -2056,9 +2138,248 @@ AudioTrigger::retrigger ()
 	retrieved = 0;
 	_legato_offset = 0; /* used one time only */
 
+	/* decided on the next run(), once the tempo is known */
+	_use_render = false;
+	_render_switch = true;
+	_retrigger_index = read_index;
+
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 retriggered to %2\n", _index, read_index));
 }
 
+AudioTrigger::StretchRender::~StretchRender ()
+{
+	for (auto& d : data) {
+		delete [] d;
+	}
+	AudioClipCache::unreserve (bytes);
+}
+
+void
+AudioTrigger::invalidate_render ()
+{
+	/* the current render (if any) will no longer match, allow a new request */
+	_data_generation.fetch_add (1);
+	_render_failed_bpm.store (0);
+	_render_requested.store (false);
+}
+
+bool
+AudioTrigger::render_usable (double bpm, uint32_t nchans) const
+{
+	return _render
+		&& _render->generation == _data_generation.load ()
+		&& _render->segment_tempo == _segment_tempo
+		&& _render->mode == _stretch_mode
+		&& _render->data.size () == nchans
+		&& fabs (_render->bpm - bpm) < 1e-6;
+}
+
+void
+AudioTrigger::use_render (double bpm, uint32_t nchans)
+{
+	/* process thread: adopt a newly rendered stretch, unless the current
+	 * one is in use. The worker empties the trash before publishing a
+	 * new render, so there is at most one item in it.
+	 */
+	if (!_use_render && !_render_trash.load ()) {
+		StretchRender* r = _pending_render.exchange (0);
+		if (r) {
+			if (_render) {
+				_render_trash.store (_render);
+				TriggerBox::worker->request_drop_render (this);
+			}
+			_render = r;
+		}
+	}
+
+	const bool usable = render_usable (bpm, nchans);
+
+	if (_use_render && !usable) {
+		/* tempo changed while playing, continue with the realtime stretcher */
+		_use_render = false;
+		reset_stretcher ();
+	} else if (!_use_render && usable && !_playout && _render_switch) {
+		/* switching from the realtime stretcher to the render while
+		 * playing would be audible, only do so at a (re)start
+		 */
+		_use_render   = true;
+		_render_index = llrint (_retrigger_index * (_segment_tempo / bpm));
+	}
+
+	_render_switch = false;
+
+	/* A render for a tempo that keeps changing (e.g. a tempo ramp) would
+	 * be outdated before it is done, wait for the tempo to settle.
+	 */
+	if (bpm != _render_bpm) {
+		_render_bpm        = bpm;
+		_render_bpm_cycles = 0;
+		return;
+	}
+
+	if (_render_bpm_cycles < render_stable_cycles) {
+		++_render_bpm_cycles;
+		return;
+	}
+
+	/* streamed and captured clips are not pre-rendered. The request keeps
+	 * a reference to the clip data, which does not change while the
+	 * trigger is active.
+	 */
+	if (!usable && _shared_data && !data.empty () && !_shared_data->empty () && data[0] == _shared_data->front () && bpm != _render_failed_bpm.load () && !_render_requested.exchange (true)) {
+		TriggerBox::worker->request_stretch_render (this, bpm, _shared_data);
+	}
+}
+
+int
+AudioTrigger::render_available () const
+{
+	/* output that corresponds to the input "consumed" so far */
+	const samplecnt_t end = std::min<samplecnt_t> (_render->length, llrint (read_index * (_render->segment_tempo / _render->bpm)));
+	return (int) std::max<samplecnt_t> (0, end - _render_index);
+}
+
+samplecnt_t
+AudioTrigger::render_retrieve (Sample* const* out, samplecnt_t cnt)
+{
+	cnt = std::min<samplecnt_t> (cnt, std::max<samplecnt_t> (0, _render->length - _render_index));
+
+	for (uint32_t chn = 0; chn < _render->data.size (); ++chn) {
+		memcpy (out[chn], _render->data[chn] + _render_index, sizeof (Sample) * cnt);
+	}
+
+	_render_index += cnt;
+	return cnt;
+}
+
+AudioTrigger::StretchRender*
+AudioTrigger::render (double bpm, AudioData const& src) const
+{
+	using namespace RubberBand;
+
+	AudioTrack const * trk = static_cast<AudioTrack*> (_box.owner());
+	assert (trk);
+
+	const uint32_t    nchans = trk->input()->n_ports().n_audio();
+	const samplecnt_t len    = src.length;
+
+	if (nchans == 0 || len == 0 || src.empty () || !src[0] || _segment_tempo <= 1 || bpm <= 0) {
+		return 0;
+	}
+
+	const double      ratio    = _segment_tempo / bpm;
+	const samplecnt_t capacity = (samplecnt_t) ceil (len * ratio) + rb_blocksize;
+	const int64_t     bytes    = capacity * nchans * sizeof (Sample);
+
+	if (!AudioClipCache::reserve (bytes)) {
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 no memory to pre-stretch %2 bytes\n", name(), bytes));
+		return 0;
+	}
+
+	StretchRender* r = new StretchRender;
+	r->bpm           = bpm;
+	r->segment_tempo = _segment_tempo;
+	r->mode          = _stretch_mode;
+	r->generation    = _data_generation.load ();
+	r->bytes         = bytes;
+
+	for (uint32_t chn = 0; chn < nchans; ++chn) {
+		r->data.push_back (new Sample[capacity]);
+	}
+
+	RubberBandStretcher::Option ro = RubberBandStretcher::Option (0);
+	switch (_stretch_mode) {
+		case Trigger::Crisp  : ro = RubberBandStretcher::OptionTransientsCrisp; break;
+		case Trigger::Mixed  : ro = RubberBandStretcher::OptionTransientsMixed; break;
+		case Trigger::Smooth : ro = RubberBandStretcher::OptionTransientsSmooth; break;
+	}
+
+	RubberBandStretcher::Options options = RubberBandStretcher::Option (RubberBandStretcher::OptionProcessOffline | RubberBandStretcher::OptionThreadingNever | ro);
+	RubberBandStretcher rb (_box.session().sample_rate(), nchans, options, ratio, 1.0);
+	rb.setMaxProcessSize (rb_blocksize);
+
+	float const** in  = (float const**) alloca (nchans * sizeof (float*));
+	float**       out = (float**) alloca (nchans * sizeof (float*));
+
+	for (samplepos_t pos = 0; pos < len; pos += rb_blocksize) {
+		const samplecnt_t n = std::min<samplecnt_t> (rb_blocksize, len - pos);
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			in[chn] = src[chn % src.size ()] + pos;
+		}
+		rb.study (in, n, pos + n >= len);
+	}
+
+	samplecnt_t length = 0;
+
+	for (samplepos_t pos = 0; pos < len; pos += rb_blocksize) {
+		const samplecnt_t n = std::min<samplecnt_t> (rb_blocksize, len - pos);
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			in[chn] = src[chn % src.size ()] + pos;
+		}
+		rb.process (in, n, pos + n >= len);
+
+		int avail;
+		while ((avail = rb.available ()) > 0 && length < capacity) {
+			const samplecnt_t cnt = std::min<samplecnt_t> (avail, capacity - length);
+			for (uint32_t chn = 0; chn < nchans; ++chn) {
+				out[chn] = r->data[chn] + length;
+			}
+			length += rb.retrieve (out, cnt);
+		}
+	}
+
+	r->length = length;
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 pre-stretched for %2 bpm, %3 -> %4 samples\n", name(), bpm, len, length));
+	return r;
+}
+
+void
+AudioTrigger::drop_render_trash ()
+{
+	/* TriggerBoxThread */
+	delete _render_trash.exchange (0);
+}
+
+void
+AudioTrigger::drop_data_trash ()
+{
+	/* TriggerBoxThread */
+	if (_data_trash_pending.load ()) {
+		_shared_data_trash.reset ();
+		_stream_trash.reset ();
+		_data_trash_pending.store (false);
+	}
+}
+
+void
+AudioTrigger::render_stretch (double bpm, std::shared_ptr<AudioData const> src)
+{
+	/* TriggerBoxThread */
+
+	drop_render_trash ();
+
+	StretchRender* r = render (bpm, *src);
+
+	if (!r) {
+		/* e.g. over the memory budget. Do not retry for the same tempo,
+		 * until the clip changes.
+		 */
+		_render_failed_bpm.store (bpm);
+		_render_requested.store (false);
+		return;
+	}
+
+	if (r->generation != _data_generation.load ()) {
+		/* data changed meanwhile */
+		delete r;
+		return;
+	}
+
+	delete _pending_render.exchange (r);
+	_render_requested.store (false);
+}
+
 template<bool in_process_context>
 pframes_t
 AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample,
@@ -2078,6 +2399,10 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 	quantize_offset = 0;
 
+	if (in_process_context && _stream && _stream->refill_needed ()) {
+		_box.set_need_butler ();
+	}
+
 	/* see if we're going to start or stop or retrigger in this run() call */
 	maybe_compute_next_transition (start_sample, start, end, nframes, quantize_offset);
 	const pframes_t orig_nframes = nframes;
@@ -2121,9 +2446,15 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		bufp[chn] = scratch->get_audio (chn).data();
 	}
 
+	if (do_stretch) {
+		use_render (bpm, nchans);
+	} else {
+		_use_render = false;
+	}
+
 	/* tell the stretcher what we are doing for this ::run() call */
 
-	if (do_stretch && !_playout) {
+	if (do_stretch && !_playout && !_use_render) {
 
 		const double stretch = _segment_tempo / bpm;
 		_stretcher->setTimeRatio (stretch);
@@ -2196,10 +2527,17 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 					 * the end of the region
 					 */
 
-					float** in = (float**)alloca(nchans * sizeof (float*));
+					if (_use_render) {
+						/* pre-rendered, the input is only used to track the position */
+						read_index += to_stretcher;
+						avail = render_available ();
+						continue;
+					}
+
+					float const** in = (float const**)alloca(nchans * sizeof (float*));
 
 					for (uint32_t chn = 0; chn < nchans; ++chn) {
-						in[chn] = data[chn % data.size ()] + read_index;
+						in[chn] = clip_data (chn % data.size (), read_index, to_stretcher);
 					}
 
 					/* Note: RubberBandStretcher's process() and retrieve() API's accepts Sample**
@@ -2231,14 +2569,18 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 			} else {
 
 				/* finished delivering data to stretcher, but may have not yet retrieved it all */
-				avail = _stretcher->available ();
+				avail = _use_render ? render_available () : _stretcher->available ();
 				from_stretcher = (pframes_t) std::min ((pframes_t) nframes, (pframes_t) avail);
 				// cerr << "FS#X from avail " << avail << " nf " << nframes << " = " << from_stretcher << endl;
 			}
 
 			/* fetch the stretch */
 
-			retrieved += _stretcher->retrieve (&bufp[0], from_stretcher);
+			if (_use_render) {
+				retrieved += render_retrieve (&bufp[0], from_stretcher);
+			} else {
+				retrieved += _stretcher->retrieve (&bufp[0], from_stretcher);
+			}
 
 			if (read_index >= last_readable_sample) {
 
@@ -2289,7 +2631,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample const* src = do_stretch ? bufp[channel] : clip_data (channel, read_index, from_stretcher);
 
 				gain_t gain;
 
@@ -2319,7 +2661,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		}
 
 		nframes -= from_stretcher;
-		avail = _stretcher->available ();
+		avail = _use_render ? render_available () : _stretcher->available ();
 		dest_offset += from_stretcher;
 
 		if (read_index >= last_readable_sample && (!do_stretch || avail <= 0)) {
@@ -2385,6 +2727,294 @@ AudioTrigger::reload (BufferSet&, void*)
 
 /*--------------------*/
 
+Glib::Threads::Mutex                                                         AudioClipCache::_lock;
+std::map<AudioClipCache::Key, std::weak_ptr<AudioTrigger::AudioData const> > AudioClipCache::_clips;
+std::atomic<int64_t>                                                         AudioClipCache::_bytes (0);
+
+bool
+AudioClipCache::Key::operator< (Key const& other) const
+{
+	if (start != other.start) {
+		return start < other.start;
+	}
+	if (length != other.length) {
+		return length < other.length;
+	}
+	return sources < other.sources;
+}
+
+std::shared_ptr<AudioTrigger::AudioData const>
+AudioClipCache::get (std::shared_ptr<AudioRegion> ar)
+{
+	const uint32_t    nchans = ar->n_channels ();
+	const samplecnt_t len    = ar->length_samples ();
+	const int64_t     bytes  = len * nchans * sizeof (Sample);
+
+	Key key;
+	key.start  = ar->start ().samples ();
+	key.length = len;
+	for (uint32_t n = 0; n < nchans; ++n) {
+		key.sources.push_back (ar->source (n)->id ());
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		auto i = _clips.find (key);
+		if (i != _clips.end ()) {
+			std::shared_ptr<AudioTrigger::AudioData const> d = i->second.lock ();
+			if (d) {
+				return d;
+			}
+		}
+
+		/* reserve memory, or stream the clip */
+		if (_bytes.load () + bytes > limit ()) {
+			return std::shared_ptr<AudioTrigger::AudioData const> ();
+		}
+		_bytes.fetch_add (bytes);
+	}
+
+	AudioTrigger::AudioData* data = new AudioTrigger::AudioData;
+
+	try {
+		data->alloc (len, nchans);
+		for (uint32_t n = 0; n < nchans; ++n) {
+			ar->read ((*data)[n], 0, len, n);
+		}
+		data->length = len;
+	} catch (...) {
+		delete data;
+		_bytes.fetch_sub (bytes);
+		throw;
+	}
+
+	std::shared_ptr<AudioTrigger::AudioData const> d (data, [key, bytes] (AudioTrigger::AudioData const* d) { release (key, d, bytes); });
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	/* another thread may have loaded the same data meanwhile */
+	auto i = _clips.find (key);
+	if (i != _clips.end ()) {
+		std::shared_ptr<AudioTrigger::AudioData const> other = i->second.lock ();
+		if (other) {
+			lm.release ();
+			return other;
+		}
+	}
+
+	_clips[key] = d;
+	return d;
+}
+
+int64_t
+AudioClipCache::limit ()
+{
+	return (int64_t) Config->get_clip_memory_megabytes () * 1048576;
+}
+
+bool
+AudioClipCache::reserve (int64_t bytes)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	if (_bytes.load () + bytes > limit ()) {
+		return false;
+	}
+	_bytes.fetch_add (bytes);
+	return true;
+}
+
+void
+AudioClipCache::release (Key const& key, AudioTrigger::AudioData const* data, int64_t bytes)
+{
+	delete data;
+	_bytes.fetch_sub (bytes);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	auto i = _clips.find (key);
+	if (i != _clips.end () && i->second.expired ()) {
+		_clips.erase (i);
+	}
+}
+
+/*--------------------*/
+
+Glib::Threads::Mutex          AudioClipStream::_streams_lock;
+std::vector<AudioClipStream*> AudioClipStream::_streams;
+
+AudioClipStream::AudioClipStream (std::shared_ptr<AudioRegion> ar)
+	: _region (ar)
+	, _n_channels (ar->n_channels ())
+	, _length (ar->length_samples ())
+	, _last_index (std::max<int64_t> (0, (_length - 1) / stride))
+	, _silence (new Sample[max_read])
+	, _position (0)
+	, _anchor (0)
+	, _refill_needed (false)
+{
+	/* the windows count towards the same memory budget as loaded clips */
+	if (!AudioClipCache::reserve (bytes ())) {
+		throw failed_constructor ();
+	}
+
+	memset (_silence.get (), 0, sizeof (Sample) * max_read);
+
+	try {
+		for (auto& w : _windows) {
+			w.index.store (-1);
+			for (uint32_t n = 0; n < _n_channels; ++n) {
+				w.data.push_back (std::unique_ptr<Sample[]> (new Sample[window_size]));
+			}
+		}
+	} catch (...) {
+		AudioClipCache::unreserve (bytes ());
+		throw;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_streams_lock);
+	_streams.push_back (this);
+}
+
+AudioClipStream::~AudioClipStream ()
+{
+	/* wait for the butler to finish a refill */
+	{
+		Glib::Threads::Mutex::Lock lm (_streams_lock);
+		_streams.erase (std::find (_streams.begin (), _streams.end (), this));
+	}
+
+	AudioClipCache::unreserve (bytes ());
+}
+
+int64_t
+AudioClipStream::bytes () const
+{
+	return (int64_t) n_windows * window_size * _n_channels * sizeof (Sample);
+}
+
+AudioClipStream::Window const*
+AudioClipStream::find (int64_t index) const
+{
+	for (auto const& w : _windows) {
+		if (w.index.load () == index) {
+			return &w;
+		}
+	}
+	return 0;
+}
+
+Sample const*
+AudioClipStream::read (uint32_t chn, samplepos_t pos, samplecnt_t cnt)
+{
+	assert (cnt <= max_read);
+
+	/* any read of up to max_read samples is contained in one window */
+	int64_t const index = pos / stride;
+
+	_position.store (index);
+
+	Window const* w = find (index);
+
+	if (!w || (index < _last_index && !find (index + 1))) {
+		_refill_needed.store (true);
+	}
+
+	if (!w) {
+		return _silence.get ();
+	}
+
+	return w->data[chn % _n_channels].get () + (pos - index * stride);
+}
+
+Sample const*
+AudioClipStream::head (samplecnt_t& cnt) const
+{
+	Window const* w = find (0);
+	if (!w) {
+		return 0;
+	}
+	cnt = std::min (window_size, _length);
+	return w->data[0].get ();
+}
+
+void
+AudioClipStream::set_anchor (samplepos_t pos, bool load_now)
+{
+	_anchor.store (pos / stride);
+	_position.store (pos / stride);
+
+	if (load_now) {
+		Glib::Threads::Mutex::Lock lm (_streams_lock);
+		_refill_needed.store (true);
+		refill ();
+	} else {
+		_refill_needed.store (true);
+	}
+}
+
+void
+AudioClipStream::load (Window& w, int64_t index)
+{
+	samplepos_t const start = index * stride;
+	samplecnt_t const cnt   = std::min (window_size, _length - start);
+
+	w.index.store (-1);
+
+	for (uint32_t n = 0; n < _n_channels; ++n) {
+		Sample* buf = w.data[n].get ();
+		if (_region->read (buf, start, cnt, n) != cnt) {
+			return;
+		}
+		if (cnt < window_size) {
+			memset (buf + cnt, 0, sizeof (Sample) * (window_size - cnt));
+		}
+	}
+
+	w.index.store (index);
+}
+
+void
+AudioClipStream::refill ()
+{
+	/* _streams_lock is held */
+
+	if (!_refill_needed.exchange (false)) {
+		return;
+	}
+
+	int64_t const position  = _position.load ();
+	int64_t const wanted[3] = { _anchor.load (), position, position + 1 };
+
+	for (auto const& index : wanted) {
+		if (index < 0 || index > _last_index || find (index)) {
+			continue;
+		}
+		/* replace a window that is not needed. The window at the
+		 * current read position is never replaced while it may be
+		 * in use by the realtime thread.
+		 */
+		for (auto& w : _windows) {
+			int64_t const i = w.index.load ();
+			if (i != wanted[0] && i != wanted[1] && i != wanted[2]) {
+				load (w, index);
+				break;
+			}
+		}
+	}
+}
+
+void
+AudioClipStream::refill_all ()
+{
+	Glib::Threads::Mutex::Lock lm (_streams_lock);
+
+	for (auto& s : _streams) {
+		s->refill ();
+	}
+}
+
+/*--------------------*/
+
 MIDITrigger::MIDITrigger (uint32_t n, TriggerBox& b)
 	: Trigger (n, b)
 	, data_length (Temporal::Beats())
@@ -3658,6 +4288,7 @@ TriggerBox::TriggerBox (Session& s, DataType dt)
 	, tracker (dt == DataType::MIDI ? new MidiStateTracker : nullptr)
 	, _data_type (dt)
 	, _order (-1)
+	, _need_butler (false)
 	, explicit_queue (64)
 	, _currently_playing (0)
 	, _stop_all (false)
@@ -4902,6 +5533,8 @@ TriggerBox::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 	   here. if so, we can just return.
 	*/
 
+	_need_butler = false;
+
 	/* STEP ONE: are we actually active? */
 
 	if (!check_active()) {
@@ -5739,6 +6372,15 @@ TriggerBoxThread::thread_work ()
 				case BuildSourceAndRegion:
 					build_source (req->trigger, req->duration);
 					break;
+				case StretchRender:
+					static_cast<AudioTrigger*> (req->trigger)->render_stretch (req->bpm, req->audio_data);
+					break;
+				case DropStretchRender:
+					static_cast<AudioTrigger*> (req->trigger)->drop_render_trash ();
+					break;
+				case DropClipData:
+					static_cast<AudioTrigger*> (req->trigger)->drop_data_trash ();
+					break;
 				default:
 					break;
 				}
@@ -5815,6 +6457,32 @@ TriggerBoxThread::request_build_source (Trigger* t, Temporal::timecnt_t const &
 	queue_request (req);
 }
 
+void
+TriggerBoxThread::request_stretch_render (AudioTrigger* t, double bpm, std::shared_ptr<AudioTrigger::AudioData const> data)
+{
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (StretchRender);
+	req->trigger    = t;
+	req->bpm        = bpm;
+	req->audio_data = data;
+	queue_request (req);
+}
+
+void
+TriggerBoxThread::request_drop_render (AudioTrigger* t)
+{
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (DropStretchRender);
+	req->trigger = t;
+	queue_request (req);
+}
+
+void
+TriggerBoxThread::request_drop_data (AudioTrigger* t)
+{
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (DropClipData);
+	req->trigger = t;
+	queue_request (req);
+}
+
 void
 TriggerBoxThread::delete_trigger (Trigger* t)
 {
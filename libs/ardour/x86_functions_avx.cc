@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+
+#ifndef __AVX__
+#error "__AVX__ must be enabled for this module to work"
+#endif
+
+/**
+ * @brief x86-64 AVX optimized routine to apply a per sample gain
+ * @param dst Pointer to destination buffer, which gets updated
+ * @param gain Pointer to gain coefficients
+ * @param nframes Number of frames to process
+ */
+void
+x86_sse_avx_apply_gain_vector_to_buffer (float* dst, const float* gain, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		__m256 x0 = _mm256_mul_ps (_mm256_loadu_ps (dst), _mm256_loadu_ps (gain));
+		__m256 x1 = _mm256_mul_ps (_mm256_loadu_ps (dst + 8), _mm256_loadu_ps (gain + 8));
+		_mm256_storeu_ps (dst, x0);
+		_mm256_storeu_ps (dst + 8, x1);
+		dst += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	if (nframes >= 8) {
+		_mm256_storeu_ps (dst, _mm256_mul_ps (_mm256_loadu_ps (dst), _mm256_loadu_ps (gain)));
+		dst += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ *= *gain++;
+		--nframes;
+	}
+
+	// There are some situations where assembly code is mixed
+	// with AVX code, and the transition penalty can be high.
+	_mm256_zeroupper ();
+}
+
+/**
+ * @brief x86-64 AVX optimized routine for mixing buffers with per sample gain
+ * @param dst Pointer to destination buffer, which gets updated
+ * @param src Pointer to source buffer (not updated)
+ * @param gain Pointer to gain coefficients
+ * @param nframes Number of frames to process
+ */
+void
+x86_sse_avx_mix_buffers_with_gain_vector (float* dst, const float* src, const float* gain, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		__m256 x0 = _mm256_mul_ps (_mm256_loadu_ps (src), _mm256_loadu_ps (gain));
+		__m256 x1 = _mm256_mul_ps (_mm256_loadu_ps (src + 8), _mm256_loadu_ps (gain + 8));
+		_mm256_storeu_ps (dst, _mm256_add_ps (_mm256_loadu_ps (dst), x0));
+		_mm256_storeu_ps (dst + 8, _mm256_add_ps (_mm256_loadu_ps (dst + 8), x1));
+		dst += 16;
+		src += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	if (nframes >= 8) {
+		__m256 x = _mm256_mul_ps (_mm256_loadu_ps (src), _mm256_loadu_ps (gain));
+		_mm256_storeu_ps (dst, _mm256_add_ps (_mm256_loadu_ps (dst), x));
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * *gain++;
+		--nframes;
+	}
+
+	_mm256_zeroupper ();
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to compute the sum of squares
+ * @param src Pointer to source buffer
+ * @param nframes Number of frames to process
+ * @return float sum of all squared samples
+ */
+float
+x86_sse_avx_sum_of_squares (const float* src, uint32_t nframes)
+{
+	__m256 acc0 = _mm256_setzero_ps ();
+	__m256 acc1 = _mm256_setzero_ps ();
+
+	while (nframes >= 16) {
+		__m256 x0 = _mm256_loadu_ps (src);
+		__m256 x1 = _mm256_loadu_ps (src + 8);
+		acc0 = _mm256_add_ps (acc0, _mm256_mul_ps (x0, x0));
+		acc1 = _mm256_add_ps (acc1, _mm256_mul_ps (x1, x1));
+		src += 16;
+		nframes -= 16;
+	}
+
+	acc0 = _mm256_add_ps (acc0, acc1);
+
+	/* horizontal sum */
+	__m128 s = _mm_add_ps (_mm256_castps256_ps128 (acc0), _mm256_extractf128_ps (acc0, 1));
+	s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+	s = _mm_add_ss (s, _mm_shuffle_ps (s, s, _MM_SHUFFLE (1, 1, 1, 1)));
+
+	float sum = _mm_cvtss_f32 (s);
+
+	while (nframes > 0) {
+		sum += *src * *src;
+		++src;
+		--nframes;
+	}
+
+	_mm256_zeroupper ();
+	return sum;
+}
@@ -1146,4 +1146,105 @@ x86_avx512f_copy_vector(float *dst, const float *src, uint32_t nframes)
 	_mm256_zeroupper(); // zeros the upper portion of YMM register
 }
 
+/**
+ * @brief x86-64 AVX-512F optimized routine to apply a per sample gain
+ * @param dst Pointer to destination buffer, which gets updated
+ * @param gain Pointer to gain coefficients
+ * @param nframes Number of frames to process
+ */
+void
+x86_avx512f_apply_gain_vector_to_buffer(float *dst, const float *gain, uint32_t nframes)
+{
+	int32_t frames = static_cast<int32_t>(nframes);
+
+	while (frames >= 16) {
+		__m512 x = _mm512_mul_ps(_mm512_loadu_ps(dst), _mm512_loadu_ps(gain));
+		_mm512_storeu_ps(dst, x);
+		dst += 16;
+		gain += 16;
+		frames -= 16;
+	}
+
+	if (frames > 0) {
+		// Process remaining samples with a mask
+		__mmask16 m = (__mmask16)((1u << frames) - 1);
+		__m512 x = _mm512_mul_ps(_mm512_maskz_loadu_ps(m, dst), _mm512_maskz_loadu_ps(m, gain));
+		_mm512_mask_storeu_ps(dst, m, x);
+	}
+
+	_mm256_zeroupper();
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized routine for mixing buffers with per sample gain
+ * @param dst Pointer to destination buffer, which gets updated
+ * @param src Pointer to source buffer (not updated)
+ * @param gain Pointer to gain coefficients
+ * @param nframes Number of frames to process
+ */
+void
+x86_avx512f_mix_buffers_with_gain_vector(float *dst, const float *src, const float *gain, uint32_t nframes)
+{
+	int32_t frames = static_cast<int32_t>(nframes);
+
+	while (frames >= 16) {
+		__m512 x = _mm512_fmadd_ps(_mm512_loadu_ps(src), _mm512_loadu_ps(gain), _mm512_loadu_ps(dst));
+		_mm512_storeu_ps(dst, x);
+		dst += 16;
+		src += 16;
+		gain += 16;
+		frames -= 16;
+	}
+
+	if (frames > 0) {
+		__mmask16 m = (__mmask16)((1u << frames) - 1);
+		__m512 x = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, src), _mm512_maskz_loadu_ps(m, gain), _mm512_maskz_loadu_ps(m, dst));
+		_mm512_mask_storeu_ps(dst, m, x);
+	}
+
+	_mm256_zeroupper();
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized routine to compute the sum of squares
+ * @param src Pointer to source buffer
+ * @param nframes Number of frames to process
+ * @return float sum of all squared samples
+ */
+float
+x86_avx512f_sum_of_squares(const float *src, uint32_t nframes)
+{
+	int32_t frames = static_cast<int32_t>(nframes);
+
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+
+	while (frames >= 32) {
+		__m512 x0 = _mm512_loadu_ps(src);
+		__m512 x1 = _mm512_loadu_ps(src + 16);
+		acc0 = _mm512_fmadd_ps(x0, x0, acc0);
+		acc1 = _mm512_fmadd_ps(x1, x1, acc1);
+		src += 32;
+		frames -= 32;
+	}
+
+	while (frames >= 16) {
+		__m512 x = _mm512_loadu_ps(src);
+		acc0 = _mm512_fmadd_ps(x, x, acc0);
+		src += 16;
+		frames -= 16;
+	}
+
+	if (frames > 0) {
+		__mmask16 m = (__mmask16)((1u << frames) - 1);
+		__m512 x = _mm512_maskz_loadu_ps(m, src);
+		acc1 = _mm512_fmadd_ps(x, x, acc1);
+	}
+
+	float sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+
+	_mm256_zeroupper();
+	return sum;
+}
+
 #endif // FPU_AVX512F_SUPPORT
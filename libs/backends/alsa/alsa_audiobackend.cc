@@ -1758,6 +1758,7 @@ AlsaAudioBackend::main_process_thread ()
 		for (std::vector<BackendPortPtr>::const_iterator it = _system_inputs.begin (); it != _system_inputs.end (); ++it) {
 			memset ((*it)->get_buffer (_samples_per_period), 0, _samples_per_period * sizeof (Sample));
 		}
+		next_process_cycle ();
 		if (engine.process_callback (_samples_per_period)) {
 			_active = false;
 			return 0;
@@ -1896,6 +1897,7 @@ AlsaAudioBackend::main_process_thread ()
 
 				/* call engine process callback */
 				_last_process_start = g_get_monotonic_time ();
+				next_process_cycle ();
 				if (engine.process_callback (_samples_per_period)) {
 					_pcmi->pcm_stop ();
 					_active = false;
@@ -1992,6 +1994,7 @@ AlsaAudioBackend::main_process_thread ()
 			pthread_mutex_unlock (&_device_port_mutex);
 
 			_last_process_start = 0;
+			next_process_cycle ();
 			if (engine.process_callback (_samples_per_period)) {
 				_pcmi->pcm_stop ();
 				_active = false;
@@ -2259,24 +2262,7 @@ void*
 AlsaAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
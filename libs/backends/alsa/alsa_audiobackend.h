@@ -74,6 +74,7 @@ class AlsaAudioPort : public BackendPort {
 
 		Sample* buffer () { return _buffer; }
 		const Sample* const_buffer () const { return _buffer; }
+		const Sample* source_buffer () const { return _buffer; }
 		void* get_buffer (pframes_t nframes);
 
 	private:
@@ -93,6 +93,7 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 		_driver_speed.push_back (DriverSpeed (_("15x Speed"),    0.06666f));
 		_driver_speed.push_back (DriverSpeed (_("20x Speed"),    0.05f));
 		_driver_speed.push_back (DriverSpeed (_("50x Speed"),    0.02f));
+		_driver_speed.push_back (DriverSpeed (X_("Benchmark"),   0.0f)); // internal name, used by hardour and scripts
 	}
 
 }
@@ -196,6 +197,10 @@ DummyAudioBackend::enumerate_drivers () const
 {
 	std::vector<std::string> speed_drivers;
 	for (std::vector<DriverSpeed>::const_iterator it = _driver_speed.begin () ; it != _driver_speed.end (); ++it) {
+		if (it->speedup == 0) {
+			/* "Benchmark" keeps a CPU core busy, it is only set explicitly by hardour or scripts */
+			continue;
+		}
 		speed_drivers.push_back (it->name);
 	}
 	return speed_drivers;
@@ -928,6 +933,7 @@ DummyAudioBackend::main_process_thread ()
 			std::dynamic_pointer_cast<DummyPort>(*it)->next_period ();
 		}
 
+		next_process_cycle ();
 		if (engine.process_callback (samples_per_period)) {
 			return 0;
 		}
@@ -969,7 +975,9 @@ DummyAudioBackend::main_process_thread ()
 
 			const int64_t elapsed_time = _dsp_load_calc.elapsed_time_us ();
 			const int64_t nominal_time = _dsp_load_calc.get_max_time_us ();
-			if (elapsed_time < nominal_time) {
+			if (_speedup == 0) {
+				/* benchmark, process as fast as possible */
+			} else if (elapsed_time < nominal_time) {
 				const int64_t sleepy = _speedup * (nominal_time - elapsed_time);
 				Glib::usleep (std::max ((int64_t) 10, sleepy));
 			} else {
@@ -1591,30 +1599,7 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
-			assert (source && source->is_output ());
-			if (source->is_physical() && source->is_terminal()) {
-				source->get_buffer(n_samples); // generate signal.
-			}
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				if (source->is_physical() && source->is_terminal()) {
-					source->get_buffer(n_samples); // generate signal.
-				}
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		mix_connections (_buffer, n_samples);
 	} else if (is_output () && is_physical () && is_terminal()) {
 		if (!_gen_cycle) {
 			generate(n_samples);
@@ -102,6 +102,7 @@ class DummyAudioPort : public DummyPort {
 
 		Sample* buffer () { return _buffer; }
 		const Sample* const_buffer () const { return _buffer; }
+		const Sample* source_buffer () const { return _buffer; }
 		void* get_buffer (pframes_t nframes);
 
 		enum GeneratorType {
@@ -128,6 +129,10 @@ class DummyAudioPort : public DummyPort {
 		void fill_wavetable (const float* d, size_t n_samples) { assert(_wavetable != 0);  memcpy(_wavetable, d, n_samples * sizeof(float)); }
 		void midi_to_wavetable (DummyMidiBuffer const * const src, size_t n_samples);
 
+	protected:
+		/* physical inputs (system capture) generate signals on demand */
+		bool generates_data () const { return is_output () && is_physical () && is_terminal (); }
+
 	private:
 		Sample _buffer[8192];
 
@@ -1625,6 +1625,7 @@ PortAudioBackend::blocking_process_main(const float* interleaved_input_data,
 	}
 
 	/* call engine process callback */
+	next_process_cycle ();
 	if (engine.process_callback(_samples_per_period)) {
 		_pcmio->close_stream();
 		_active = false;
@@ -1678,6 +1679,7 @@ PortAudioBackend::blocking_process_freewheel()
 
 	// TODO clear midi or stop midi recv when entering fwheelin'
 
+	next_process_cycle ();
 	if (engine.process_callback(_samples_per_period)) {
 		_pcmio->close_stream();
 		_active = false;
@@ -1872,23 +1874,7 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
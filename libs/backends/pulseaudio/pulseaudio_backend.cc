@@ -1005,6 +1005,7 @@ PulseAudioBackend::main_process_thread ()
 			int64_t clock1 = g_get_monotonic_time ();
 			/* call engine process callback */
 			_last_process_start = g_get_monotonic_time ();
+			next_process_cycle ();
 			if (engine.process_callback (_samples_per_period)) {
 				pa_threaded_mainloop_unlock (p_mainloop);
 				_active = false;
@@ -1042,6 +1043,7 @@ PulseAudioBackend::main_process_thread ()
 		} else {
 			/* Freewheelin' */
 			_last_process_start = 0;
+			next_process_cycle ();
 			if (engine.process_callback (_samples_per_period)) {
 				_active = false;
 				PBD::error << _("PulseAudioBackend::main_process_thread freewheeling engine.process_callback failed.") << endmsg;
@@ -1163,25 +1165,7 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
-
-		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
-		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = _buffer;
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
-			}
-		}
+		mix_connections (_buffer, n_samples);
 	}
 	return _buffer;
 }
@@ -35,6 +35,7 @@
 
 #define GUARD_POINT_DELTA(foo) ((foo).time_domain () == Temporal::AudioTime ? Temporal::timecnt_t (64) : Temporal::timecnt_t (Beats (0, 1)))
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -73,6 +74,7 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc,
 {
 	_frozen                     = 0;
 	_changed_when_thawed        = false;
+	_revision                   = 0;
 	_lookup_cache.left          = timepos_t::max (time_domain());
 	_lookup_cache.range.first   = _events.end ();
 	_lookup_cache.range.second  = _events.end ();
@@ -95,6 +97,7 @@ ControlList::ControlList (const ControlList& other)
 {
 	_frozen                     = 0;
 	_changed_when_thawed        = false;
+	_revision                   = 0;
 	_lookup_cache.range.first   = _events.end ();
 	_lookup_cache.range.second  = _events.end ();
 	_search_cache.first         = _events.end ();
@@ -118,10 +121,12 @@ ControlList::ControlList (const ControlList& other, timepos_t const& start, time
 {
 	_frozen                    = 0;
 	_changed_when_thawed       = false;
+	_revision                  = 0;
 	_lookup_cache.range.first  = _events.end ();
 	_lookup_cache.range.second = _events.end ();
 	_search_cache.first        = _events.end ();
 	_sort_pending              = false;
+	_in_write_pass             = false;
 
 	/* now grab the relevant points, and shift them back if necessary */
 
@@ -133,7 +138,6 @@ ControlList::ControlList (const ControlList& other, timepos_t const& start, time
 	}
 
 	new_write_pass              = true;
-	_in_write_pass              = false;
 	did_write_during_pass       = false;
 	insert_position             = timepos_t::max (time_domain());
 	most_recent_insert_iterator = _events.end ();
@@ -548,6 +552,12 @@ ControlList::write_pass_finished (timepos_t const& /*when*/, double thinning_fac
 	}
 	new_write_pass = true;
 	_in_write_pass = false;
+
+	if (!_frozen) {
+		/* points added during the pass are indexed in one go */
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		unlocked_rebuild_rt_index ();
+	}
 }
 
 void
@@ -560,6 +570,9 @@ ControlList::set_in_write_pass (bool yn, bool add_point, timepos_t when)
 	if (yn && add_point) {
 		Glib::Threads::RWLock::WriterLock lm (_lock);
 		add_guard_point (when, timecnt_t (time_domain()));
+	} else if (!yn && !_frozen) {
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		unlocked_rebuild_rt_index ();
 	}
 }
 
@@ -625,6 +638,7 @@ ControlList::add_guard_point (timepos_t const& time, timecnt_t const& offset)
 		DEBUG_TRACE (DEBUG::ControlList, string_compose ("@%1 insert iterator at end, adding eval-value there %2\n", this, eval_value));
 		_events.push_back (new ControlEvent (when, eval_value));
 		/* leave insert iterator at the end */
+		unlocked_invalidate_rt_index ();
 
 	} else if ((*most_recent_insert_iterator)->when == when) {
 		DEBUG_TRACE (DEBUG::ControlList, string_compose ("@%1 insert iterator at existing point, setting eval-value there %2\n", this, eval_value));
@@ -648,6 +662,7 @@ ControlList::add_guard_point (timepos_t const& time, timecnt_t const& offset)
 		                                                 this, eval_value, (*most_recent_insert_iterator)->when));
 
 		most_recent_insert_iterator = _events.insert (most_recent_insert_iterator, new ControlEvent (when, eval_value));
+		unlocked_invalidate_rt_index ();
 
 		/* advance most_recent_insert_iterator so that the "real"
 		 * insert occurs in the right place, since it
@@ -1322,6 +1337,10 @@ ControlList::thaw ()
 			unlocked_remove_duplicates ();
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
+			mark_dirty ();
+		}
+		if (!_in_write_pass) {
+			unlocked_rebuild_rt_index ();
 		}
 	}
 	maybe_signal_changed ();
@@ -1330,15 +1349,95 @@ ControlList::thaw ()
 void
 ControlList::mark_dirty () const
 {
+	unlocked_invalidate_rt_index ();
+
+	if (!_frozen && !_in_write_pass) {
+		unlocked_rebuild_rt_index ();
+	}
+
+	if (_curve) {
+		_curve->mark_dirty ();
+	}
+}
+
+void
+ControlList::unlocked_invalidate_rt_index () const
+{
+	/* _lock must be held for writing */
 	_lookup_cache.left         = timepos_t::max (time_domain());
 	_lookup_cache.range.first  = _events.end ();
 	_lookup_cache.range.second = _events.end ();
 	_search_cache.left         = timepos_t::max (time_domain());
 	_search_cache.first        = _events.end ();
+	_rt_index.valid            = false;
+	++_revision;
+}
 
-	if (_curve) {
-		_curve->mark_dirty ();
+void
+ControlList::unlocked_rebuild_rt_index () const
+{
+	/* _lock must be held for writing */
+	if (_rt_index.valid || _sort_pending) {
+		return;
+	}
+
+	_rt_index.beat_time = time_domain () == Temporal::BeatTime;
+	_rt_index.when.clear ();
+	_rt_index.value.clear ();
+	_rt_index.iter.clear ();
+
+	_rt_index.when.reserve (_events.size ());
+	_rt_index.value.reserve (_events.size ());
+	_rt_index.iter.reserve (_events.size () + 1);
+
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i) {
+		_rt_index.when.push_back (_rt_index.key ((*i)->when));
+		_rt_index.value.push_back ((*i)->value);
+		_rt_index.iter.push_back (i);
 	}
+	_rt_index.iter.push_back (_events.end ());
+
+	_rt_index.valid = true;
+}
+
+/** @return index of the first event that is not before \a t */
+size_t
+ControlList::rt_index_lower_bound (timepos_t const& t) const
+{
+	assert (_rt_index.valid);
+
+	std::vector<int64_t> const& when (_rt_index.when);
+
+	size_t i = std::lower_bound (when.begin (), when.end (), _rt_index.key (t)) - when.begin ();
+
+	/* keys of positions in a different time-domain are rounded,
+	 * correct the result using exact comparison */
+	while (i > 0 && !((*_rt_index.iter[i - 1])->when < t)) {
+		--i;
+	}
+	while (i < when.size () && (*_rt_index.iter[i])->when < t) {
+		++i;
+	}
+	return i;
+}
+
+/** @return index of the first event that is after \a t */
+size_t
+ControlList::rt_index_upper_bound (timepos_t const& t) const
+{
+	assert (_rt_index.valid);
+
+	std::vector<int64_t> const& when (_rt_index.when);
+
+	size_t i = std::upper_bound (when.begin (), when.end (), _rt_index.key (t)) - when.begin ();
+
+	while (i > 0 && t < (*_rt_index.iter[i - 1])->when) {
+		--i;
+	}
+	while (i < when.size () && !(t < (*_rt_index.iter[i])->when)) {
+		++i;
+	}
+	return i;
 }
 
 void
@@ -1617,6 +1716,16 @@ ControlList::multipoint_eval (timepos_t const& xtime) const
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
+		if (_rt_index.valid) {
+			size_t i = rt_index_lower_bound (xtime);
+			assert (i < _rt_index.value.size ());
+			if (i == 0 || (*_rt_index.iter[i])->when == xtime) {
+				return _rt_index.value[i];
+			} else {
+				return _rt_index.value[i - 1];
+			}
+		}
+
 		const ControlEvent        cp (xtime, 0);
 		EventList::const_iterator i = lower_bound (_events.begin (), _events.end (), &cp, time_comparator);
 
@@ -1635,9 +1744,13 @@ ControlList::multipoint_eval (timepos_t const& xtime) const
 	    ((_lookup_cache.left > xtime) ||
 	     (_lookup_cache.range.first == _events.end ()) ||
 	     ((*_lookup_cache.range.second)->when < xtime))) {
-		const ControlEvent cp (xtime, 0);
-
-		_lookup_cache.range = equal_range (_events.begin (), _events.end (), &cp, time_comparator);
+		if (_rt_index.valid) {
+			_lookup_cache.range.first  = _rt_index.iter[rt_index_lower_bound (xtime)];
+			_lookup_cache.range.second = _rt_index.iter[rt_index_upper_bound (xtime)];
+		} else {
+			const ControlEvent cp (xtime, 0);
+			_lookup_cache.range = equal_range (_events.begin (), _events.end (), &cp, time_comparator);
+		}
 	}
 
 	pair<const_iterator, const_iterator> range = _lookup_cache.range;
@@ -1690,6 +1803,16 @@ ControlList::multipoint_eval (timepos_t const& xtime) const
 	return (*range.first)->value;
 }
 
+ControlList::const_iterator
+ControlList::unlocked_upper_bound (timepos_t const& x) const
+{
+	if (_rt_index.valid) {
+		return _rt_index.iter[rt_index_upper_bound (x)];
+	}
+	const ControlEvent cp (x, 0);
+	return upper_bound (_events.begin (), _events.end (), &cp, time_comparator);
+}
+
 void
 ControlList::build_search_cache_if_necessary (timepos_t const& start_time) const
 {
@@ -1703,17 +1826,27 @@ ControlList::build_search_cache_if_necessary (timepos_t const& start_time) const
 	} else if ((_search_cache.left == timepos_t::max (time_domain())) || (_search_cache.left > start)) {
 		/* Marked dirty (left == max), or we're too far forward, re-search. */
 
-		const ControlEvent start_point (start, 0);
-
-		_search_cache.first = lower_bound (_events.begin (), _events.end (), &start_point, time_comparator);
-		_search_cache.left  = start;
+		if (_rt_index.valid) {
+			_search_cache.first = _rt_index.iter[rt_index_lower_bound (start)];
+		} else {
+			const ControlEvent start_point (start, 0);
+			_search_cache.first = lower_bound (_events.begin (), _events.end (), &start_point, time_comparator);
+		}
+		_search_cache.left = start;
 	}
 
 	/* We now have a search cache that is not too far right, but it may be too
 	   far left and need to be advanced. */
 
-	while (_search_cache.first != end () && (*_search_cache.first)->when < start) {
-		++_search_cache.first;
+	if (_search_cache.first != end () && (*_search_cache.first)->when < start) {
+		if (_rt_index.valid) {
+			/* all events before `first' are earlier than `start', too */
+			_search_cache.first = _rt_index.iter[rt_index_lower_bound (start)];
+		} else {
+			while (_search_cache.first != end () && (*_search_cache.first)->when < start) {
+				++_search_cache.first;
+			}
+		}
 	}
 	_search_cache.left = start;
 }
@@ -2277,6 +2410,7 @@ ControlList::finish_domain_bounce (Temporal::DomainBounceInfo& dbi)
 			t.set_time_domain (dbi.from);
 			e->when = t;
 		}
+		mark_dirty ();
 	}
 
 	maybe_signal_changed ();
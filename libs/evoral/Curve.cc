@@ -379,11 +379,137 @@ Curve::_get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *vec,
 		dx = (hx - lx) / (veclen - 1);
 	}
 
+	if (_list.interpolation() != ControlList::Curved) {
+		get_segments (lx, dx, x0.is_beats(), vec, veclen);
+		return;
+	}
+
 	for (i = 0; i < veclen; ++i, rx += dx) {
 		vec[i] = multipoint_eval (x0.is_beats() ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
 	}
 }
 
+/** Evaluate the list at x0 + i * dx for i in [0, veclen).
+ *
+ * Rather than looking up every sample, this walks the segments between
+ * control points and fills each run of samples in one go.
+ * x0 must be within the range of the control points.
+ */
+void
+Curve::get_segments (double x0, double dx, bool beats, float* vec, int32_t veclen) const
+{
+	ControlList::EventList const& events (_list.events());
+
+	ControlList::const_iterator after = _list.unlocked_upper_bound (beats ? Temporal::timepos_t::from_ticks (x0) : Temporal::timepos_t::from_superclock (x0));
+	assert (after != events.begin());
+
+	int32_t i = 0;
+
+	while (i < veclen) {
+
+		if (after == events.end()) {
+			/* at or after the last point */
+			const float val = events.back()->value;
+			for (; i < veclen; ++i) {
+				vec[i] = val;
+			}
+			break;
+		}
+
+		ControlList::const_iterator b = after;
+		--b;
+		ControlEvent const* before = *b;
+		ControlEvent const* next   = *after;
+		++after;
+
+		const double bw = before->when.val();
+		const double aw = next->when.val();
+
+		/* samples [i, n) are before `next' */
+		int32_t n = veclen;
+
+		if (dx > 0) {
+			const double e = ceil ((aw - x0) / dx);
+			n = e < i ? i : (e > veclen ? veclen : (int32_t) e);
+			while (n > i && x0 + (n - 1) * dx >= aw) {
+				--n;
+			}
+			while (n < veclen && x0 + n * dx < aw) {
+				++n;
+			}
+		} else if (x0 >= aw) {
+			n = i;
+		}
+
+		if (n > i) {
+			fill_segment (before->value, next->value, x0 + i * dx - bw, dx, aw - bw, vec + i, n - i);
+			i = n;
+		}
+	}
+}
+
+/** Fill \a n samples between two control points with values \a lval and \a uval.
+ *
+ * @param x offset of the first sample from the first point
+ * @param dx distance between samples
+ * @param range distance between the points
+ */
+void
+Curve::fill_segment (double lval, double uval, double x, double dx, double range, float* vec, int32_t n) const
+{
+	if (lval == uval || _list.interpolation() == ControlList::Discrete) {
+		for (int32_t i = 0; i < n; ++i) {
+			vec[i] = lval;
+		}
+		return;
+	}
+
+	const double f0 = x / range;
+	const double df = dx / range;
+
+	switch (_list.interpolation()) {
+		case ControlList::Logarithmic:
+			{
+				assert (lval > 0 && lval * uval > 0);
+				/* lval * pow (uval / lval, fraction) */
+				const double lr = log (uval / lval);
+				for (int32_t i = 0; i < n; ++i) {
+					vec[i] = lval * exp (lr * (f0 + i * df));
+				}
+			}
+			break;
+		case ControlList::Exponential:
+			{
+				/* interpolate_gain(), with the end-points mapped once */
+				const double upper = _list.descriptor().upper;
+				const double from  = lval + TINY_NUMBER;
+				const double to    = uval + TINY_NUMBER;
+				if (fabs (to - from) < TINY_NUMBER) {
+					for (int32_t i = 0; i < n; ++i) {
+						vec[i] = to;
+					}
+					break;
+				}
+				const double g0   = gain_to_position (from * 2. / upper);
+				const double diff = gain_to_position (to * 2. / upper) - g0;
+				for (int32_t i = 0; i < n; ++i) {
+					vec[i] = position_to_gain (g0 + (f0 + i * df) * diff) * upper / 2.;
+				}
+			}
+			break;
+		default: // Linear
+			{
+				/* v[i] = a + b * i, vectorizable */
+				const double a = lval + f0 * (uval - lval);
+				const double b = df * (uval - lval);
+				for (int32_t i = 0; i < n; ++i) {
+					vec[i] = a + b * i;
+				}
+			}
+			break;
+	}
+}
+
 double
 Curve::multipoint_eval (Temporal::timepos_t const & x) const
 {
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -316,6 +317,9 @@ public:
 	 */
 	double unlocked_eval (Temporal::timepos_t const & x) const;
 
+	/** @return the first event after \a x. The caller must hold the lock. */
+	const_iterator unlocked_upper_bound (Temporal::timepos_t const & x) const;
+
 	bool rt_safe_earliest_event_discrete_unlocked (Temporal::timepos_t const & start, Temporal::timepos_t & x, double& y, bool inclusive) const;
 	bool rt_safe_earliest_event_linear_unlocked (Temporal::timepos_t const & start, Temporal::timepos_t & x, double& y, bool inclusive, Temporal::timecnt_t min_x_delta = Temporal::timecnt_t::max()) const;
 
@@ -327,6 +331,9 @@ public:
 
 	void mark_dirty () const;
 
+	/** @return a number that changes whenever the events of the list are modified */
+	uint64_t revision () const { return _revision; }
+
 	enum InterpolationStyle {
 		Discrete,
 		Linear,
@@ -394,8 +401,33 @@ public:
 
 	void _x_scale (Temporal::ratio_t const &);
 
+	/** Contiguous, sorted copy of the event times and values.
+	 *
+	 * The EventList remains a linked list since iterators into it have to
+	 * stay valid while points are added and removed (GUI, write-passes).
+	 * Time lookups in the process thread use a binary search on this index
+	 * rather than walking the list. It is rebuilt with the write-lock held
+	 * by mark_dirty(), except while the list is frozen or during a
+	 * write-pass, in which case it is rebuilt once by thaw() or when the
+	 * write-pass ends. Meanwhile lookups fall back to the list.
+	 * Guard points added at the start of a write-pass invalidate it, too.
+	 */
+	struct RTIndex {
+		RTIndex () : valid (false), beat_time (false) {}
+		std::vector<int64_t>        when;  /* superclock or ticks */
+		std::vector<double>         value;
+		std::vector<const_iterator> iter;  /* size () + 1, last is _events.end () */
+		bool                        valid;
+		bool                        beat_time;
+
+		int64_t key (Temporal::timepos_t const & t) const {
+			return beat_time ? t.ticks () : t.superclocks ();
+		}
+	};
+
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
+	mutable RTIndex       _rt_index;
 
 	mutable Glib::Threads::RWLock _lock;
 
@@ -406,6 +438,7 @@ public:
 	int8_t                _frozen;
 	bool                  _changed_when_thawed;
 	bool                  _sort_pending;
+	mutable uint64_t      _revision; /* incremented by mark_dirty() and add_guard_point() */
 
 	Curve* _curve;
 
@@ -418,6 +451,10 @@ public:
 
 	void unlocked_remove_duplicates ();
 	void unlocked_invalidate_insert_iterator ();
+	void unlocked_invalidate_rt_index () const;
+	void unlocked_rebuild_rt_index () const;
+	size_t rt_index_lower_bound (Temporal::timepos_t const &) const;
+	size_t rt_index_upper_bound (Temporal::timepos_t const &) const;
 	void add_guard_point (Temporal::timepos_t const & when, Temporal::timecnt_t const & offset);
 
 	bool is_sorted () const;
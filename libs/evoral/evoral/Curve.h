@@ -47,6 +47,8 @@ private:
 	double multipoint_eval (Temporal::timepos_t const & x) const;
 
 	void _get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *arg, int32_t veclen) const;
+	void get_segments (double x0, double dx, bool beats, float *vec, int32_t veclen) const;
+	void fill_segment (double lval, double uval, double x, double dx, double range, float *vec, int32_t n) const;
 
 	mutable bool       _dirty;
 	const ControlList& _list;
@@ -342,6 +342,119 @@ CurveTest::ctrlListEval ()
 	CPPUNIT_ASSERT_EQUAL(9.0, cl->unlocked_eval(t999));
 }
 
+void
+CurveTest::denseEval ()
+{
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+
+	/* points at x = 0, 10, 20, .. with y = 0, 1, 2 .. */
+	cl->freeze ();
+	for (int i = 0; i < 1000; ++i) {
+		cl->fast_simple_add (timepos_t (i * 10), i);
+	}
+	cl->thaw ();
+
+	cl->set_interpolation (ControlList::Discrete);
+	CPPUNIT_ASSERT_EQUAL(0.0, cl->unlocked_eval(timepos_t (5)));
+	CPPUNIT_ASSERT_EQUAL(500.0, cl->unlocked_eval(timepos_t (5000)));
+	CPPUNIT_ASSERT_EQUAL(500.0, cl->unlocked_eval(timepos_t (5009)));
+	CPPUNIT_ASSERT_EQUAL(999.0, cl->unlocked_eval(timepos_t (20000)));
+
+	cl->set_interpolation (ControlList::Linear);
+	for (int i = 0; i < 999; i += 7) {
+		CPPUNIT_ASSERT_EQUAL((double)i, cl->unlocked_eval(timepos_t (i * 10)));
+		CPPUNIT_ASSERT_EQUAL(i + .5, cl->unlocked_eval(timepos_t (i * 10 + 5)));
+	}
+	/* backwards, the lookup-cache has to re-search */
+	CPPUNIT_ASSERT_EQUAL(100.5, cl->unlocked_eval(timepos_t (1005)));
+	CPPUNIT_ASSERT_EQUAL(10.5, cl->unlocked_eval(timepos_t (105)));
+
+	/* step through the events, jumping ahead once */
+	timepos_t x;
+	double    y;
+	CPPUNIT_ASSERT(cl->rt_safe_earliest_event_discrete_unlocked (timepos_t (15), x, y, true));
+	CPPUNIT_ASSERT_EQUAL(timepos_t (20), x);
+	CPPUNIT_ASSERT(cl->rt_safe_earliest_event_discrete_unlocked (x, x, y, false));
+	CPPUNIT_ASSERT_EQUAL(timepos_t (30), x);
+	CPPUNIT_ASSERT(cl->rt_safe_earliest_event_discrete_unlocked (timepos_t (7001), x, y, true));
+	CPPUNIT_ASSERT_EQUAL(timepos_t (7010), x);
+	CPPUNIT_ASSERT_EQUAL(701.0, y);
+	CPPUNIT_ASSERT(!cl->rt_safe_earliest_event_discrete_unlocked (timepos_t (9991), x, y, true));
+
+	/* modifications are visible, also while frozen */
+	cl->add (timepos_t (5005), 42.0, false, false);
+	CPPUNIT_ASSERT_EQUAL(42.0, cl->unlocked_eval(timepos_t (5005)));
+
+	cl->freeze ();
+	cl->erase (timepos_t (5005), 42.0);
+	CPPUNIT_ASSERT_EQUAL(500.5, cl->unlocked_eval(timepos_t (5005)));
+	cl->thaw ();
+	CPPUNIT_ASSERT_EQUAL(500.5, cl->unlocked_eval(timepos_t (5005)));
+}
+
+void
+CurveTest::multiPointVector ()
+{
+	float vec[1024];
+
+	Evoral::Parameter param (Evoral::Parameter(0));
+	Evoral::ParameterDescriptor desc;
+	desc.upper = 2;
+
+	ControlList::InterpolationStyle styles[] = { ControlList::Discrete, ControlList::Linear, ControlList::Exponential };
+
+	for (int s = 0; s < 3; ++s) {
+		std::shared_ptr<Evoral::ControlList> cl (new Evoral::ControlList (param, desc, Temporal::TimeDomainProvider (Temporal::AudioTime)));
+		cl->create_curve ();
+		CPPUNIT_ASSERT (cl->set_interpolation (styles[s]));
+
+		/* irregularly spaced points, some closer than a sample apart on the vector */
+		cl->fast_simple_add (timepos_t (0), 0.0);
+		cl->fast_simple_add (timepos_t (100), 1.0);
+		cl->fast_simple_add (timepos_t (101), 0.5);
+		cl->fast_simple_add (timepos_t (300), 0.5);
+		cl->fast_simple_add (timepos_t (301), 1.5);
+		cl->fast_simple_add (timepos_t (302), 1.0);
+		cl->fast_simple_add (timepos_t (777), 2.0);
+		cl->fast_simple_add (timepos_t (2000), 0.25);
+
+		/* one sample per position */
+		cl->curve ().get_vector (timepos_t (50), timepos_t (1073), vec, 1024);
+
+		for (int i = 0; i < 1024; ++i) {
+			char msg[64];
+			snprintf (msg, 64, "at i=%d interpolation=%d", i, (int) styles[s]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, cl->unlocked_eval (timepos_t (50 + i)), vec[i], 1e-5);
+		}
+	}
+}
+
+void
+CurveTest::writePassGuardPoint ()
+{
+	timepos_t x;
+	double    y;
+
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	CPPUNIT_ASSERT (cl->set_interpolation (ControlList::Linear));
+	cl->fast_simple_add (timepos_t (0), 0.0);
+	cl->fast_simple_add (timepos_t (1000), 1.0);
+
+	/* prime the search cache */
+	CPPUNIT_ASSERT (cl->rt_safe_earliest_event_discrete_unlocked (timepos_t (100), x, y, true));
+	CPPUNIT_ASSERT_EQUAL (timepos_t (1000), x);
+
+	/* write pass without any writes, only the guard point is added */
+	cl->set_in_write_pass (true, true, timepos_t (500));
+	cl->write_pass_finished (timepos_t (600));
+
+	CPPUNIT_ASSERT_EQUAL ((ControlList::EventList::size_type) 3, cl->size ());
+	CPPUNIT_ASSERT (cl->rt_safe_earliest_event_discrete_unlocked (timepos_t (100), x, y, true));
+	CPPUNIT_ASSERT_EQUAL (timepos_t (500), x);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, y, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.5, cl->unlocked_eval (timepos_t (500)), 1e-9);
+}
+
 void
 CurveTest::constrainedCubic ()
 {
@@ -15,6 +15,9 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (denseEval);
+	CPPUNIT_TEST (multiPointVector);
+	CPPUNIT_TEST (writePassGuardPoint);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -25,6 +28,9 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void denseEval ();
+	void multiPointVector ();
+	void writePassGuardPoint ();
 
 private:
 	std::shared_ptr<Evoral::ControlList> TestCtrlList() {
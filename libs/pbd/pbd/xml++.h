@@ -79,7 +79,7 @@ public:
 	~XMLTree();
 
 	XMLNode* root() const         { return _root; }
-	XMLNode* set_root(XMLNode* n) { return _root = n; }
+	XMLNode* set_root(XMLNode* n) { drop_doc (); return _root = n; }
 
 	const std::string& filename() const               { return _filename; }
 	const std::string& set_filename(const std::string& fn) { return _filename = fn; }
@@ -93,6 +93,12 @@ public:
 	bool read_and_validate(const std::string& fn) { set_filename(fn); return read_internal(true); }
 	bool read_buffer(char const*, bool to_tree_doc = false);
 
+	/* read() and read_buffer() build the XMLNode tree while parsing,
+	 * without creating an intermediate libxml2 document. This reads
+	 * a file into a libxml2 document first, and keeps it for find().
+	 */
+	bool read_document(const std::string& fn) { set_filename(fn); return read_document_internal(false); }
+
 	bool write() const;
 	bool write(const std::string& fn) { set_filename(fn); return write(); }
 
@@ -100,14 +106,21 @@ public:
 
 	const std::string& write_buffer() const;
 
+	/* Without a node, queries run on the document kept by read_document(),
+	 * or on one built from the tree by the first query. Changes made to
+	 * the tree afterwards are not seen until it is read or set again.
+	 */
 	std::shared_ptr<XMLSharedNodeList> find(const std::string xpath, XMLNode* = 0) const;
 
 private:
 	bool read_internal(bool validate);
+	bool read_document_internal(bool validate);
+	void drop_doc ();
 
 	std::string _filename;
 	XMLNode*    _root;
-	xmlDocPtr   _doc;
+	/* kept by read_document(), or built on demand by find() */
+	mutable xmlDocPtr _doc;
 	int         _compression;
 };
 
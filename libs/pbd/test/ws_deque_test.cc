@@ -0,0 +1,89 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ws_deque_test.h"
+#include "pbd/ws_deque.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WSDequeTest);
+
+using namespace std;
+
+void
+WSDequeTest::testBasic ()
+{
+	PBD::WSDeque<intptr_t> d (4);
+	intptr_t v;
+
+	CPPUNIT_ASSERT_EQUAL ((size_t)4, d.capacity ());
+	CPPUNIT_ASSERT (d.empty ());
+	CPPUNIT_ASSERT (!d.pop_back (v));
+	CPPUNIT_ASSERT (!d.steal (v));
+
+	for (intptr_t i = 1; i <= 4; ++i) {
+		CPPUNIT_ASSERT (d.push_back (i));
+	}
+	/* bounded, does not grow */
+	CPPUNIT_ASSERT (!d.push_back (5));
+
+	/* owner pops LIFO */
+	CPPUNIT_ASSERT (d.pop_back (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)4, v);
+
+	/* thieves steal FIFO */
+	CPPUNIT_ASSERT (d.steal (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)1, v);
+
+	CPPUNIT_ASSERT (d.pop_back (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)3, v);
+	CPPUNIT_ASSERT (d.pop_back (v));
+	CPPUNIT_ASSERT_EQUAL ((intptr_t)2, v);
+	CPPUNIT_ASSERT (!d.pop_back (v));
+	CPPUNIT_ASSERT (d.empty ());
+}
+
+void
+WSDequeTest::testSteal ()
+{
+	const intptr_t n_items = 100000;
+
+	PBD::WSDeque<intptr_t> d (n_items);
+	vector<atomic<int> >   seen (n_items + 1);
+	atomic<bool>           done (false);
+
+	for (auto& s : seen) {
+		s.store (0);
+	}
+
+	auto thief = [&] () {
+		intptr_t v;
+		while (!done.load ()) {
+			if (d.steal (v)) {
+				seen[v].fetch_add (1);
+			}
+		}
+	};
+
+	thread t1 (thief);
+	thread t2 (thief);
+
+	intptr_t v;
+	for (intptr_t i = 1; i <= n_items; ++i) {
+		CPPUNIT_ASSERT (d.push_back (i));
+		if (i % 3 == 0 && d.pop_back (v)) {
+			seen[v].fetch_add (1);
+		}
+	}
+	while (d.pop_back (v)) {
+		seen[v].fetch_add (1);
+	}
+
+	done.store (true);
+	t1.join ();
+	t2.join ();
+
+	/* every item was taken exactly once */
+	for (intptr_t i = 1; i <= n_items; ++i) {
+		CPPUNIT_ASSERT_EQUAL (1, seen[i].load ());
+	}
+}
@@ -0,0 +1,15 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class WSDequeTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (WSDequeTest);
+	CPPUNIT_TEST (testBasic);
+	CPPUNIT_TEST (testSteal);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	WSDequeTest () { }
+	void testBasic ();
+	void testSteal ();
+};
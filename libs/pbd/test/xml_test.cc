@@ -83,6 +83,46 @@ XMLTest::testXMLFilenameEncoding ()
 	}
 }
 
+void
+XMLTest::testStreamingRead ()
+{
+	std::string testdata_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "RosegardenPatchFile.xml", testdata_path));
+
+	XMLTree document;
+	CPPUNIT_ASSERT (document.read_document (testdata_path));
+
+	XMLTree streamed;
+	CPPUNIT_ASSERT (streamed.read (testdata_path));
+
+	// the streaming reader must produce the same tree
+	CPPUNIT_ASSERT (*document.root () == *streamed.root ());
+
+	// xpath queries also work without a libxml2 document
+	std::shared_ptr<XMLSharedNodeList> a = document.find ("//program");
+	std::shared_ptr<XMLSharedNodeList> b = streamed.find ("//program");
+	CPPUNIT_ASSERT (!a->empty ());
+	CPPUNIT_ASSERT_EQUAL (a->size (), b->size ());
+	// the document built for the first query is re-used
+	CPPUNIT_ASSERT_EQUAL (b->size (), streamed.find ("//program")->size ());
+
+	XMLTree buffer;
+	CPPUNIT_ASSERT (buffer.read_buffer ("<a x=\"1\"><b>text</b><!-- comment --><c/></a>"));
+	CPPUNIT_ASSERT_EQUAL (std::string ("1"), buffer.root ()->property ("x")->value ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, buffer.root ()->children ().size ());
+	CPPUNIT_ASSERT_EQUAL (std::string ("text"), buffer.root ()->child ("b")->child_content ());
+
+	// CDATA sections are read as by the document reader
+	const char* cdata = "<a><b><![CDATA[x < y]]></b></a>";
+	XMLTree cdata_doc;
+	CPPUNIT_ASSERT (cdata_doc.read_buffer (cdata, true));
+	CPPUNIT_ASSERT (buffer.read_buffer (cdata));
+	CPPUNIT_ASSERT (*cdata_doc.root () == *buffer.root ());
+	CPPUNIT_ASSERT_EQUAL (cdata_doc.root ()->child ("b")->children ().front ()->name (),
+	                      buffer.root ()->child ("b")->children ().front ()->name ());
+
+	CPPUNIT_ASSERT (!buffer.read_buffer ("<a><b></a>"));
+}
 
 static const char * const root_node_name = "Session";
 static const char * const child_node_name = "Child";
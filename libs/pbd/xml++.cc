@@ -13,6 +13,7 @@
 #include "pbd/xml++.h"
 
 #include <libxml/debugXML.h>
+#include <libxml/xmlreader.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
 
@@ -21,6 +22,7 @@ xmlChar* xml_version = xmlCharStrdup("1.0");
 using namespace std;
 
 static XMLNode*           readnode(xmlNodePtr);
+static XMLNode*           readstream(xmlTextReaderPtr);
 static void               writenode(xmlDocPtr, XMLNode*, xmlNodePtr, int);
 static XMLSharedNodeList* find_impl(xmlXPathContext* ctxt, const string& xpath);
 
@@ -59,6 +61,15 @@ XMLTree::~XMLTree()
 	}
 }
 
+void
+XMLTree::drop_doc ()
+{
+	if (_doc) {
+		xmlFreeDoc (_doc);
+		_doc = 0;
+	}
+}
+
 int
 XMLTree::set_compression(int c)
 {
@@ -75,6 +86,30 @@ XMLTree::set_compression(int c)
 
 bool
 XMLTree::read_internal(bool validate)
+{
+	if (validate) {
+		return read_document_internal(validate);
+	}
+
+	delete _root;
+	_root = 0;
+
+	drop_doc ();
+
+	xmlTextReaderPtr reader = xmlReaderForFile(_filename.c_str(), NULL, XML_PARSE_HUGE | XML_PARSE_NOBLANKS);
+	if (reader == NULL) {
+		return false;
+	}
+
+	_root = readstream(reader);
+
+	xmlFreeTextReader(reader);
+
+	return _root != 0;
+}
+
+bool
+XMLTree::read_document_internal(bool validate)
 {
 	//shouldnt be used anywhere ATM, remove if so!
 	assert(!validate);
@@ -82,10 +117,7 @@ XMLTree::read_internal(bool validate)
 	delete _root;
 	_root = 0;
 
-	if (_doc) {
-		xmlFreeDoc (_doc);
-		_doc = 0;
-	}
+	drop_doc ();
 
 	/* Calling this prevents libxml2 from treating whitespace as active
 	   nodes. It needs to be called before we create a parser context.
@@ -134,6 +166,17 @@ XMLTree::read_buffer (char const* buffer, bool to_tree_doc)
 
 	delete _root;
 	_root = 0;
+	drop_doc ();
+
+	if (!to_tree_doc) {
+		xmlTextReaderPtr reader = xmlReaderForMemory(buffer, ::strlen(buffer), NULL, NULL, XML_PARSE_NOBLANKS);
+		if (reader == NULL) {
+			return false;
+		}
+		_root = readstream(reader);
+		xmlFreeTextReader(reader);
+		return _root != 0;
+	}
 
 	xmlKeepBlanksDefault(0);
 
@@ -471,6 +514,14 @@ XMLTree::find(const string xpath, XMLNode* node) const
 	xmlXPathContext* ctxt;
 	xmlDocPtr doc = 0;
 
+	if (!node && !_doc) {
+		/* the tree was read without keeping a libxml2 document;
+		 * build one once and keep it for subsequent queries.
+		 */
+		_doc = xmlNewDoc(xml_version);
+		writenode(_doc, _root, _doc->children, 1);
+	}
+
 	if (node) {
 		doc = xmlNewDoc(xml_version);
 		writenode(doc, node, doc->children, 1);
@@ -479,8 +530,17 @@ XMLTree::find(const string xpath, XMLNode* node) const
 		ctxt = xmlXPathNewContext(_doc);
 	}
 
-	std::shared_ptr<XMLSharedNodeList> result =
-		std::shared_ptr<XMLSharedNodeList>(find_impl(ctxt, xpath));
+	std::shared_ptr<XMLSharedNodeList> result;
+
+	try {
+		result = std::shared_ptr<XMLSharedNodeList>(find_impl(ctxt, xpath));
+	} catch (...) {
+		xmlXPathFreeContext(ctxt);
+		if (doc) {
+			xmlFreeDoc (doc);
+		}
+		throw;
+	}
 
 	xmlXPathFreeContext(ctxt);
 	if (doc) {
@@ -760,6 +820,81 @@ readnode(xmlNodePtr node)
 	return tmp;
 }
 
+/* Build the tree directly from parser events. The result is identical to
+ * readnode() of the document, except that only elements, text and comments
+ * are retained; there is no intermediate libxml2 document.
+ */
+static XMLNode*
+readstream(xmlTextReaderPtr reader)
+{
+	XMLNode* root = 0;
+	std::vector<XMLNode*> parents;
+	int rv;
+
+	while ((rv = xmlTextReaderRead(reader)) == 1) {
+		XMLNode* tmp;
+		bool is_element = false;
+
+		switch (xmlTextReaderNodeType(reader)) {
+		case XML_READER_TYPE_ELEMENT:
+			is_element = true;
+			tmp = new XMLNode((const char*)xmlTextReaderConstLocalName(reader));
+			while (xmlTextReaderMoveToNextAttribute(reader) == 1) {
+				if (xmlTextReaderIsNamespaceDecl(reader)) {
+					continue;
+				}
+				const xmlChar* value = xmlTextReaderConstValue(reader);
+				tmp->set_property((const char*)xmlTextReaderConstLocalName(reader), value ? string((const char*)value) : string());
+			}
+			xmlTextReaderMoveToElement(reader);
+			break;
+		case XML_READER_TYPE_TEXT:
+		case XML_READER_TYPE_WHITESPACE:
+		case XML_READER_TYPE_SIGNIFICANT_WHITESPACE:
+			tmp = new XMLNode("text");
+			tmp->set_content((const char*)xmlTextReaderConstValue(reader));
+			break;
+		case XML_READER_TYPE_CDATA:
+			/* libxml2 CDATA section nodes have no name */
+			tmp = new XMLNode("");
+			tmp->set_content((const char*)xmlTextReaderConstValue(reader));
+			break;
+		case XML_READER_TYPE_COMMENT:
+			tmp = new XMLNode("comment");
+			tmp->set_content((const char*)xmlTextReaderConstValue(reader));
+			break;
+		case XML_READER_TYPE_END_ELEMENT:
+			if (!parents.empty()) {
+				parents.pop_back();
+			}
+			continue;
+		default:
+			continue;
+		}
+
+		if (!parents.empty()) {
+			parents.back()->add_child_nocopy(*tmp);
+		} else if (is_element && !root) {
+			root = tmp;
+		} else {
+			/* top-level comments are not part of the tree */
+			delete tmp;
+			continue;
+		}
+
+		if (is_element && !xmlTextReaderIsEmptyElement(reader)) {
+			parents.push_back(tmp);
+		}
+	}
+
+	if (rv != 0) {
+		delete root;
+		return 0;
+	}
+
+	return root;
+}
+
 static void
 writenode(xmlDocPtr doc, XMLNode* n, xmlNodePtr p, int root = 0)
 {
@@ -796,17 +931,11 @@ static XMLSharedNodeList* find_impl(xmlXPathContext* ctxt, const string& xpath)
 	xmlXPathObject* result = xmlXPathEval((const xmlChar*)xpath.c_str(), ctxt);
 
 	if (!result) {
-		xmlFreeDoc(ctxt->doc);
-		xmlXPathFreeContext(ctxt);
-
 		throw XMLException("Invalid XPath: " + xpath);
 	}
 
 	if (result->type != XPATH_NODESET) {
 		xmlXPathFreeObject(result);
-		xmlFreeDoc(ctxt->doc);
-		xmlXPathFreeContext(ctxt);
-
 		throw XMLException("Only nodeset result types are supported.");
 	}
 
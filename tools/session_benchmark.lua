@@ -0,0 +1,39 @@
+-- cd gtk2_ardour; ./arlua < ../tools/session_benchmark.lua
+
+-- This script creates a session with some tracks, starts playback
+-- and processes a given number of cycles as fast as possible
+-- using the Dummy backend. Statistics are printed as JSON.
+
+n_cycles = 10000 -- process cycles to measure
+n_tracks = 32    -- number of tracks to create
+
+backend = AudioEngine:set_backend("None (Dummy)", "", "")
+backend:set_device_name ("Uniform White Noise")
+backend:set_driver ("Benchmark")
+
+os.execute('rm -rf /tmp/luabench')
+s = create_session ("/tmp/luabench", "luabench", 48000)
+assert (s)
+
+s:new_audio_track (1, 2, nil, n_tracks, "",  ARDOUR.PresentationInfo.max_order, ARDOUR.TrackMode.Normal, true)
+
+s:goto_start()
+s:request_roll (ARDOUR.TransportRequestSource.TRS_UI)
+while not s:transport_rolling () do
+	ARDOUR.LuaAPI.usleep (10000)
+end
+
+assert (0 == AudioEngine:start_benchmark (n_cycles))
+while not AudioEngine:benchmark_done () do
+	assert (s:transport_rolling (), "transport stopped during the benchmark")
+	ARDOUR.LuaAPI.usleep (10000)
+end
+
+print (AudioEngine:benchmark_report ())
+if AudioEngine:benchmark_underruns () > 0 then
+	print ("Warning: disk i/o did not keep up, results are not representative")
+end
+
+s:request_stop (false, false, ARDOUR.TransportRequestSource.TRS_UI);
+close_session()
+quit()